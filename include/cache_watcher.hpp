@@ -0,0 +1,35 @@
+#pragma once
+#include <string>
+#include <map>
+#include <cstdint>
+
+namespace ve {
+    // Polls a directory for added, removed or rewritten files with one
+    // extension (size and mtime). A change is only reported once the listing
+    // reads the same on two polls in a row, so a file an external fetcher is
+    // still writing is not picked up half-done.
+    class CacheWatcher {
+    public:
+        explicit CacheWatcher(std::string dir, std::string extension = ".txt");
+
+        // Takes the current listing as the baseline (e.g. after our own downloads)
+        void snapshot();
+        // True once per settled change since the baseline
+        bool poll();
+
+    private:
+        struct Stamp {
+            int64_t size;
+            int64_t mtime;
+            bool operator==(const Stamp& o) const { return size == o.size && mtime == o.mtime; }
+        };
+        using Listing = std::map<std::string, Stamp>;
+        Listing scan() const;
+
+        std::string dir_;
+        std::string extension_;
+        Listing baseline_;
+        Listing pending_;
+        bool has_pending_ = false;
+    };
+}
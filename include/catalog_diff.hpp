@@ -0,0 +1,76 @@
+#pragma once
+#include <vector>
+#include <algorithm>
+#include <cstdint>
+#include <cstddef>
+
+namespace ve {
+    struct CatalogDiff {
+        size_t kept = 0;        // Same NORAD id and element lines
+        size_t changed = 0;     // Same NORAD id, new element set
+        size_t added = 0;
+        size_t removed = 0;
+        // live was replaced by a new vector: indices and pointers into it (the
+        // SoA batch, the pass horizon cursor) must be rebuilt. Can be set even
+        // when unchanged(), e.g. a duplicate dropped from the fresh set.
+        bool swapped = false;
+        bool unchanged() const { return changed == 0 && added == 0 && removed == 0; }
+    };
+
+    // Merges a freshly loaded catalog into the live one, matching by NORAD id and
+    // element-line hash (T provides getNoradId(), getTleHash() and
+    // adoptElements(const T&)). The result follows fresh's order; entries whose
+    // elements did not change keep the live object, with its passes, trail and
+    // ephemeris, but adopt fresh's copy of the elements so the previous load's
+    // storage is released; the rest come from fresh.
+    // Live entries missing from fresh are dropped. When nothing changed, live is
+    // left untouched so indices held elsewhere stay valid.
+    template <typename T>
+    CatalogDiff mergeCatalog(std::vector<T>& live, std::vector<T>&& fresh) {
+        struct Key { int id; uint64_t hash; size_t index; };
+        auto less = [](const Key& a, const Key& b) { return a.id < b.id || (a.id == b.id && a.hash < b.hash); };
+        auto less_id = [](const Key& a, const Key& b) { return a.id < b.id; };
+
+        // 1. Live entries sorted by (id, hash); fresh ids for the removal count
+        std::vector<Key> keys;
+        keys.reserve(live.size());
+        for (size_t i = 0; i < live.size(); ++i) keys.push_back({live[i].getNoradId(), live[i].getTleHash(), i});
+        std::sort(keys.begin(), keys.end(), less);
+        std::vector<int> fresh_ids;
+        fresh_ids.reserve(fresh.size());
+        for (const auto& f : fresh) fresh_ids.push_back(f.getNoradId());
+        std::sort(fresh_ids.begin(), fresh_ids.end());
+
+        // 2. Pair each fresh entry with an unused live one (duplicates pair in order)
+        CatalogDiff diff;
+        std::vector<size_t> source(fresh.size(), SIZE_MAX);
+        std::vector<bool> taken(keys.size(), false);
+        for (size_t j = 0; j < fresh.size(); ++j) {
+            Key k{fresh[j].getNoradId(), fresh[j].getTleHash(), 0};
+            auto it = std::lower_bound(keys.begin(), keys.end(), k, less);
+            for (; it != keys.end() && it->id == k.id && it->hash == k.hash; ++it) {
+                size_t n = static_cast<size_t>(it - keys.begin());
+                if (!taken[n]) { taken[n] = true; source[j] = it->index; break; }
+            }
+            if (source[j] != SIZE_MAX) diff.kept++;
+            else if (std::binary_search(keys.begin(), keys.end(), k, less_id)) diff.changed++;
+            else diff.added++;
+        }
+        for (const auto& k : keys) {
+            if (!std::binary_search(fresh_ids.begin(), fresh_ids.end(), k.id)) diff.removed++;
+        }
+        if (diff.unchanged() && fresh.size() == live.size()) return diff;
+
+        // 3. Assemble and swap in
+        std::vector<T> merged;
+        merged.reserve(fresh.size());
+        for (size_t j = 0; j < fresh.size(); ++j) {
+            if (source[j] == SIZE_MAX) { merged.push_back(std::move(fresh[j])); continue; }
+            live[source[j]].adoptElements(fresh[j]);
+            merged.push_back(std::move(live[source[j]]));
+        }
+        live.swap(merged);
+        diff.swapped = true;
+        return diff;
+    }
+}
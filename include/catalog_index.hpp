@@ -0,0 +1,62 @@
+#pragma once
+#include "tle_parser.hpp"
+#include <string>
+#include <string_view>
+#include <vector>
+#include <unordered_map>
+#include <cstdint>
+
+namespace ve {
+    // One element set in the master catalog (owned copies; the source files
+    // are unmapped once the index is built)
+    struct CatalogEntry {
+        int norad_id;
+        std::string name;
+        std::string intl_designator;    // As in line 1 columns 10-17, e.g. "98067A"
+        std::string line1, line2;
+        std::string source;             // Cache file stem it came from
+    };
+
+    // Search index over every cached element set, built once and then read-only
+    // (safe to query from any thread). Lookups:
+    //   - NORAD id: hash map
+    //   - international designator and normalized name: sorted arrays, so a
+    //     prefix is one binary search (type-ahead)
+    //   - name substring: trigram posting lists over the normalized names,
+    //     intersected and then verified
+    //   - many patterns at once (--satsel lists): an Aho-Corasick automaton run
+    //     once over each name instead of one scan per pattern
+    // Names are normalized to upper case with every run of other characters
+    // collapsed to one space, so "ISS (ZARYA)" is found by "iss zarya".
+    class CatalogIndex {
+    public:
+        // First record per NORAD id wins; call build() after the last add
+        void add(const TleRecord& record, std::string_view source);
+        void build();
+
+        size_t size() const { return entries_.size(); }
+        const std::vector<CatalogEntry>& entries() const { return entries_; }
+
+        const CatalogEntry* findNorad(int norad_id) const;
+        // Type-ahead: exact id, then designator prefix, then name prefix, then
+        // name substring (3+ characters); within a group by designator or name
+        std::vector<const CatalogEntry*> search(std::string_view query, size_t limit) const;
+        // Every entry whose name contains any of the patterns, in catalog order.
+        // pattern_hit (optional) reports which patterns matched at least once.
+        std::vector<const CatalogEntry*> matchAny(const std::vector<std::string>& patterns,
+                                                  std::vector<bool>* pattern_hit = nullptr) const;
+
+        static std::string normalize(std::string_view text);
+        // "1998-067A" or "98067A" -> "98067A"; empty if it is neither form
+        static std::string designatorKey(std::string_view text);
+
+    private:
+        std::vector<CatalogEntry> entries_;
+        std::vector<std::string> norm_names_;                   // Per entry
+        std::unordered_map<int, uint32_t> by_norad_;
+        std::vector<uint32_t> by_name_;                         // Entry indices sorted by normalized name
+        std::vector<uint32_t> by_designator_;                   // Entry indices sorted by designator
+        std::vector<uint32_t> trigram_offsets_;                 // CSR posting lists, one per trigram
+        std::vector<uint32_t> trigram_entries_;
+    };
+}
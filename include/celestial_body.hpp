@@ -0,0 +1,48 @@
+#pragma once
+#include "types.hpp"
+#include "pass_schedule.hpp"
+#include <string>
+#include <vector>
+
+namespace ve {
+    // Sun or Moon picked with --satsel. Positions are analytic, evaluated once
+    // per tick into the FrameContext and shared, instead of running a dummy
+    // element set through SGP4, the pass search and the ground track. Rise and
+    // set times come from the pass predictor's bracketing search.
+    class CelestialBody {
+    public:
+        enum class Kind { SUN, MOON };
+        // Ids used for rows, /api/select and the rotator
+        static constexpr int SUN_ID = -1;
+        static constexpr int MOON_ID = -2;
+
+        explicit CelestialBody(Kind kind) : kind_(kind) {}
+
+        Kind kind() const { return kind_; }
+        int getNoradId() const { return kind_ == Kind::SUN ? SUN_ID : MOON_ID; }
+        const char* getName() const { return kind_ == Kind::SUN ? "SUN" : "MOON"; }
+        // Geocentric, same frame as the satellites (km)
+        Vector3 positionEci(const TimePoint& t) const;
+
+        // Low-precision lunar theory of the Astronomical Almanac: about 0.3 deg in
+        // longitude, 0.2 deg in latitude and 0.2% in distance over 1950-2050
+        static Vector3 moonPositionEci(const JulianTime& t);
+
+        // "SUN" / "MOON" (upper case); anything else is a catalog name
+        static bool isBodyName(const std::string& name);
+        // The bodies named in a comma-separated --satsel list, each once
+        static std::vector<CelestialBody> fromSelection(const std::string& csv);
+
+        // Rise/set events (0 deg horizon) searched up to until
+        using PassEvent = PassSchedule::Event;
+        void setPassEvents(std::vector<PassEvent> events, const TimePoint& until);
+        // First event after t via the schedule cursor; not thread safe
+        const PassEvent* nextEvent(const TimePoint& t) const { return schedule_.next(t); }
+        TimePoint getPredictedUntil() const { return predicted_until_; }
+
+    private:
+        Kind kind_;
+        mutable PassSchedule schedule_;
+        TimePoint predicted_until_{};
+    };
+}
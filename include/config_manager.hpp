@@ -11,9 +11,14 @@ namespace ve {
         double min_el = 0.0;
         double max_apo = -1.0;
         int trail_length_mins = 5;
+        // Chebyshev ephemeris cache: max position error vs SGP4 (km); <= 0 disables
+        double ephemeris_tolerance_km = 0.05;
+        std::string sort_by = "el";    // Display order: el, range, aos, flare
         bool visible_only = false; // true = Show ONLY Visible; false = Show All (subject to other filters)
         std::string group_selection = "active"; 
         std::string sat_selection = ""; // Specific Satellite Names
+        // gp.php-style endpoint the groups are fetched from (a local mirror in tests)
+        std::string tle_source_url = "https://celestrak.org/NORAD/elements/gp.php";
 
         // Hardware Control Settings
         bool radio_control_enabled = false;
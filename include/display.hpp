@@ -7,6 +7,7 @@
 #include "satellite.hpp"
 #include "observer.hpp"
 #include "visibility.hpp"
+#include "event_timeline.hpp"
 
 namespace ve {
     struct DisplayRow {
@@ -20,32 +21,43 @@ namespace ve {
         double apogee; 
         VisibilityCalculator::State state;
         int norad_id;
-        std::string next_event; 
+        // Next predicted AOS/LOS; each renderer formats the countdown against its own clock
+        bool pending;           // Predictions not computed yet
+        bool has_next_event;
+        bool next_is_aos;
+        TimePoint next_event_time;
         int flare_status; // 0=None, 1=Near (0.5-1.0 deg), 2=Hit (<0.5 deg)
     };
+    // "AOS 12m 5s" / "LOS 1h 3m" countdown to the row's next event, "--" if none,
+    // "pending" while its predictions are still being computed
+    std::string formatNextEvent(const DisplayRow& r, const TimePoint& now);
+
     class Display {
     public:
         enum class InputResult { NONE, QUIT_NO_SAVE, SAVE_AND_QUIT, BREAK_LOOP };
         Display();
         ~Display();
-        void update(const std::vector<DisplayRow>& rows, const Observer& obs, const TimePoint& t, int total_tracked, int filter_kept, bool show_all_rf, double min_el, const std::string& time_str);
+        // timeline feeds the pass list view ('p'); may be null before the first snapshot
+        void update(const std::vector<DisplayRow>& rows, const Geodetic& obs, const TimePoint& t, int total_tracked, int quarantined, int filter_kept, bool show_all_rf, double min_el, const std::string& time_str,
+                    const EventTimeline* timeline);
         InputResult handleInput();
         
         void setBlocking(bool blocking);
-        
-        // THREAD SAFE GETTER
-        std::string getLastFrame() const; 
+
+        // Plain-text table for the text server (sorted by name); no ncurses state
+        static std::string renderText(const std::vector<DisplayRow>& rows, const Geodetic& obs, const TimePoint& t, const std::string& time_str);
 
     private:
         enum class InputMode { NORMAL, CONFIRM_QUIT };
+        enum class View { TRACKER, PASSES };
         InputMode input_mode_;
+        View view_ = View::TRACKER;
         void initColors();
-        void drawHeader(const Observer& obs, int visible, int total, int kept, const std::string& time_str);
+        void drawHeader(const Geodetic& loc, int visible, int total, int quarantined, int kept, const std::string& time_str);
         void drawFooter();
+        void drawPasses(const EventTimeline* timeline, const TimePoint& t, double min_el);
         void drawScrollbar(int total_rows, int visible_rows);
         int scroll_offset_;
-        std::string last_frame_buffer_;
-        mutable std::mutex frame_mutex_; 
         int last_key_debug_; 
     };
 }
@@ -0,0 +1,71 @@
+#pragma once
+#include "types.hpp"
+#include "sgp4_kernel.hpp"
+#include <string_view>
+#include <vector>
+#include <memory>
+#include <unordered_set>
+#include <cstdint>
+
+namespace ve {
+    // Hot per-object state: everything propagation, the batch engine and the
+    // tick filters read, in one fixed-size cache-line aligned block
+    struct alignas(64) ElementRecord {
+        int32_t norad_id = 0;           // 0 = the element set failed to parse
+        Sgp4Model model = Sgp4Model::INVALID;
+        uint64_t tle_hash = 0;          // FNV-1a of the two element lines
+        JulianTime epoch;
+        double apogee_km = 0.0, perigee_km = 0.0, period_min = 0.0;
+        Sgp4Elements elements{};
+        Sgp4NearEarth near_earth{};
+
+        // Apogee, perigee and period from the mean elements
+        void deriveOrbit();
+    };
+
+    // Fixed-capacity arena of element sets for one load (a group file, its
+    // compiled catalog, a --satsel match). Records sit back to back in one
+    // aligned block; names and element lines are cold and go to a separate
+    // text arena, with names interned (debris clouds share a handful of names
+    // across thousands of objects). A Satellite refers to a slot and shares
+    // ownership of the store, so moving one moves a pointer and an index.
+    // Slots are filled before the store is shared and it is read-only after:
+    // setText is serial, records of distinct slots may be filled concurrently.
+    class ElementStore {
+    public:
+        explicit ElementStore(size_t capacity);
+        ElementStore(const ElementStore&) = delete;
+        ElementStore& operator=(const ElementStore&) = delete;
+
+        size_t size() const { return records_.size(); }
+
+        void setText(size_t i, std::string_view name, std::string_view line1, std::string_view line2);
+        ElementRecord& record(size_t i) { return records_[i]; }
+        const ElementRecord& record(size_t i) const { return records_[i]; }
+        std::string_view name(size_t i) const { return {text_[i].name, text_[i].name_len}; }
+        std::string_view line1(size_t i) const { return {text_[i].line1, text_[i].line1_len}; }
+        std::string_view line2(size_t i) const { return {text_[i].line2, text_[i].line2_len}; }
+
+        // Records, text and bookkeeping, for the load log
+        size_t memoryBytes() const;
+
+        static constexpr size_t BLOCK_SIZE = 64 * 1024;
+
+    private:
+        struct TextRef {
+            const char* name = "";
+            const char* line1 = "";
+            const char* line2 = "";
+            uint16_t name_len = 0, line1_len = 0, line2_len = 0;
+        };
+
+        std::vector<ElementRecord> records_;
+        std::vector<TextRef> text_;
+        // Text blocks never move once allocated, so views into them stay valid
+        std::vector<std::unique_ptr<char[]>> blocks_;
+        size_t block_used_ = BLOCK_SIZE;
+        std::unordered_set<std::string_view> names_;
+
+        const char* copy(std::string_view s);
+    };
+}
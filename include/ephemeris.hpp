@@ -0,0 +1,55 @@
+#pragma once
+#include "types.hpp"
+#include <vector>
+#include <functional>
+
+namespace ve {
+    // Piecewise Chebyshev fit of one object's ECI state over a prediction horizon.
+    // Segments start at half an orbit and are halved until the fitted position
+    // matches the sampler (SGP4) within tolerance between the fit nodes;
+    // velocity is the derivative of the fit.
+    // Coefficients are stored as float: a full catalog over 24h then fits in
+    // tens of MB, and float rounding (< 1 m at LEO radius) stays well inside
+    // any sensible tolerance.
+    class ChebyshevEphemeris {
+    public:
+        static constexpr int DEGREE = 11;
+        static constexpr int COEFFS = DEGREE + 1;
+        static constexpr double MIN_SPAN_MINS = 2.0;
+
+        // Plain data, so a fit can be written to and mapped back from disk
+        struct Segment {
+            double t0, t1;
+            float c[3][COEFFS];
+        };
+
+        // Returns false if the state cannot be computed (decay / SGP4 error)
+        using Sampler = std::function<bool(double tsince, Vector3& pos, Vector3& vel)>;
+
+        // Fit [t_begin, t_end) in minutes since TLE epoch. Coverage stops early at
+        // the first segment the sampler cannot produce.
+        bool build(const Sampler& sample, double t_begin, double t_end, double period_mins, double tolerance_km);
+
+        bool covers(double tsince) const { return !segments_.empty() && tsince >= t_begin_ && tsince < t_end_; }
+        // Position (km) and velocity (km/s); false if tsince is outside the fitted span
+        bool evaluate(double tsince, Vector3& pos, Vector3& vel) const;
+
+        size_t segmentCount() const { return segments_.size(); }
+        double maxErrorKm() const { return max_error_km_; }
+        double beginMinutes() const { return t_begin_; }
+        double endMinutes() const { return t_end_; }
+
+        const std::vector<Segment>& segments() const { return segments_; }
+        // Restore a previous fit; segments must be contiguous and sorted
+        bool assign(std::vector<Segment> segments, double max_error_km);
+
+    private:
+        bool fitSegment(const Sampler& sample, double t0, double t1, double tolerance_km, int depth);
+        static void evalSegment(const Segment& s, double tsince, Vector3& pos, Vector3& vel);
+
+        std::vector<Segment> segments_;   // Contiguous, sorted by t0
+        double t_begin_ = 0.0;
+        double t_end_ = 0.0;
+        double max_error_km_ = 0.0;
+    };
+}
@@ -0,0 +1,51 @@
+#pragma once
+#include "types.hpp"
+#include <vector>
+#include <string>
+#include <memory>
+#include <cstdint>
+
+namespace ve {
+    // Catalog-wide index of predicted passes: one immutable snapshot of every
+    // satellite's pass records. Passes are [aos, los] intervals held in an
+    // implicit interval tree: the array is sorted by AOS, the middle of each
+    // index range is that range's node, and every node stores the latest LOS
+    // in its subtree. A window query skips subtrees that set before the window
+    // or rise after it, so it costs O(log n + k) and returns passes in AOS order.
+    class EventTimeline {
+    public:
+        struct Pass {
+            int norad_id;
+            uint32_t sat;           // Index into the snapshot's names
+            TimePoint aos, tca, los;
+            double max_el;
+            double aos_az, tca_az, los_az;
+            bool has_aos, has_los;  // False where the pass was clipped by the search window
+        };
+        enum class EventType { AOS, TCA, LOS };
+        struct Event { TimePoint time; EventType type; const Pass* pass; };
+
+        EventTimeline(std::vector<Pass> passes, std::vector<std::string> names);
+
+        // Passes overlapping [from, to] that culminate at or above min_el, in AOS order
+        std::vector<const Pass*> query(const TimePoint& from, const TimePoint& to, double min_el = 0.0) const;
+        // The first count passes not yet set at t: those in progress, then by AOS
+        std::vector<const Pass*> nextPasses(const TimePoint& t, size_t count, double min_el = 0.0) const;
+        // AOS, TCA and LOS of the passes above, inside [from, to] and merged in time order
+        std::vector<Event> events(const TimePoint& from, const TimePoint& to, double min_el = 0.0) const;
+
+        const std::string& name(const Pass& p) const { return names_[p.sat]; }
+        size_t size() const { return passes_.size(); }
+
+    private:
+        void collect(size_t lo, size_t hi, const TimePoint& from, const TimePoint& to, double min_el,
+                     std::vector<const Pass*>& out) const;
+        TimePoint buildMaxLos(size_t lo, size_t hi);
+
+        std::vector<Pass> passes_;          // Sorted by AOS
+        std::vector<TimePoint> max_los_;    // Per node: latest LOS in its subtree
+        std::vector<std::string> names_;
+    };
+
+    using TimelinePtr = std::shared_ptr<const EventTimeline>;
+}
@@ -0,0 +1,39 @@
+#pragma once
+#include "display.hpp"
+#include "config_manager.hpp"
+#include "event_timeline.hpp"
+#include <memory>
+#include <atomic>
+#include <cstdint>
+
+namespace ve {
+    // Everything the consumers show for one tick, built once by the math thread
+    // and never modified after publication. The JSON body and the plain-text
+    // view are rendered here too, so the HTTP and text servers just send bytes.
+    struct Frame {
+        uint64_t seq = 0;
+        TimePoint time{};               // Physics time of the tick
+        std::string time_str;           // Display clock at the tick
+        Geodetic observer{};
+        AppConfig config;               // Filters in force for this frame
+        int total_tracked = 0;
+        int quarantined = 0;            // Tracked objects out of propagation (see TrackStatus)
+        std::vector<DisplayRow> rows;   // Filtered and sorted for display
+        std::string json;               // /api/satellites body
+        std::string text;               // Text server view
+        TimelinePtr timeline;           // Pass index; shared by frames until it is rebuilt
+        // /api/quarantine body; shared by frames until the quarantined set changes
+        std::shared_ptr<const std::string> quarantine_json;
+    };
+
+    // Single-slot mailbox: the math thread swaps in a new frame, readers take a
+    // reference to whatever is current. A reader holding an old frame keeps it
+    // alive until it lets go; nobody copies rows or blocks the writer.
+    class FrameChannel {
+    public:
+        void publish(std::shared_ptr<const Frame> frame) { std::atomic_store(&frame_, std::move(frame)); }
+        std::shared_ptr<const Frame> latest() const { return std::atomic_load(&frame_); }
+    private:
+        std::shared_ptr<const Frame> frame_;
+    };
+}
@@ -0,0 +1,37 @@
+#pragma once
+#include "types.hpp"
+#include "observer.hpp"
+#include "satellite_batch.hpp"
+
+namespace ve {
+    // Everything that depends only on the tick time and the observer, computed
+    // once per tick and shared by every satellite evaluated in that tick.
+    struct FrameContext {
+        FrameContext(const TimePoint& t, const Observer& observer, const SatelliteBatch* batch = nullptr);
+
+        TimePoint time;
+        JulianTime jtime;
+        double jd;
+        double gmst;                // Radians
+
+        // Observer in ECI (km, km/s) and its geocentric direction
+        Vector3 obs_pos;
+        Vector3 obs_vel;
+        Vector3 obs_dir;
+
+        // Topocentric (SEZ) rotation: rows of the ECI -> south/east/zenith matrix
+        Vector3 south;
+        Vector3 east;
+        Vector3 zenith;
+
+        // Sun (ECI km), its direction and its elevation at the observer (radians)
+        Vector3 sun;
+        Vector3 sun_dir;
+        double sun_el;
+        // Moon (ECI km); Sun and Moon rows read these rather than evaluating again
+        Vector3 moon;
+
+        // Per-satellite ECI state for this tick (indexed like the catalog)
+        const SatelliteBatch* states;
+    };
+}
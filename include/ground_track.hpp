@@ -0,0 +1,49 @@
+#pragma once
+#include "types.hpp"
+#include <vector>
+#include <functional>
+
+namespace ve {
+    // Sliding +/- half_width window of sub-satellite points in a fixed-capacity
+    // ring buffer. advance() only drops expired samples from the tail of the
+    // trail and appends the ones that became due at the head, so a tick costs
+    // one or two propagations instead of a full recompute.
+    //
+    // Sampling is adaptive: each step targets a fixed distance on the
+    // equirectangular map, so fast LEO passes and high latitudes (where
+    // longitude changes quickly) get denser points, GEO gets few.
+    class GroundTrack {
+    public:
+        struct Point { TimePoint t; Geodetic geo; };
+        // Returns false if no valid position exists at t (decay / propagation error)
+        using Sampler = std::function<bool(const TimePoint& t, Geodetic& geo)>;
+
+        static constexpr int MIN_STEP_SECS = 10;
+        static constexpr double TARGET_STEP_DEG = 3.0;
+
+        // Rebuild the window around now. max_step_secs bounds the sparsest sampling.
+        void reset(const TimePoint& now, int half_width_mins, int max_step_secs, const Sampler& sample);
+        // Slide the window to now; falls back to reset() on jumps larger than the window
+        void advance(const TimePoint& now, const Sampler& sample);
+
+        std::vector<Geodetic> copy() const;
+        size_t size() const { return count_; }
+        bool empty() const { return count_ == 0; }
+
+    private:
+        const Point& at(size_t i) const { return buf_[(head_ + i) % buf_.size()]; }
+        void push(const Point& p);
+        void popFront();
+        int stepSecs(const Point& a, const Point& b) const;
+        int nextStepSecs(const Sampler& sample) const;
+        void fillTo(const TimePoint& end, const Sampler& sample);
+
+        std::vector<Point> buf_;
+        size_t head_ = 0;       // Oldest sample
+        size_t count_ = 0;
+        TimePoint now_{};
+        TimePoint next_t_{};    // Time of the next sample to take
+        std::chrono::seconds half_width_{0};
+        int max_step_secs_ = 60;
+    };
+}
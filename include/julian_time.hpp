@@ -0,0 +1,59 @@
+#pragma once
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+
+namespace ve {
+    using Clock = std::chrono::system_clock;
+    using TimePoint = std::chrono::time_point<Clock>;
+
+    // Julian date split into the Julian day at 0h UT (always x.5) and the fraction
+    // of the day. Built from integer microseconds, so it keeps sub-millisecond
+    // resolution, needs no calendar conversion and touches no libc static state
+    // (safe to use from any thread).
+    struct JulianTime {
+        double day = 0.0;
+        double frac = 0.0;
+
+        static constexpr double UNIX_EPOCH_JD = 2440587.5;      // 1970-01-01 0h
+        static constexpr double TICKS_EPOCH_JD = 1721425.5;     // 0001-01-01 0h (libsgp4 DateTime ticks)
+        static constexpr int64_t US_PER_DAY = 86400000000LL;
+
+        // Microseconds since the given 0h epoch
+        static JulianTime fromMicros(int64_t us, double epoch_jd) {
+            int64_t days = us / US_PER_DAY;
+            int64_t rem = us % US_PER_DAY;
+            if (rem < 0) { rem += US_PER_DAY; days -= 1; }
+            return { epoch_jd + static_cast<double>(days), static_cast<double>(rem) / static_cast<double>(US_PER_DAY) };
+        }
+
+        static JulianTime fromTimePoint(const TimePoint& t) {
+            auto us = std::chrono::duration_cast<std::chrono::microseconds>(t.time_since_epoch()).count();
+            return fromMicros(us, UNIX_EPOCH_JD);
+        }
+
+        static JulianTime fromTicks(int64_t ticks) { return fromMicros(ticks, TICKS_EPOCH_JD); }
+
+        static JulianTime fromJulian(double jd) {
+            double d = std::floor(jd - 0.5) + 0.5;
+            return { d, jd - d };
+        }
+
+        double jd() const { return day + frac; }
+
+        // Minutes since an epoch (e.g. the TLE epoch), as libsgp4's SGP4::FindPosition(double) expects
+        double minutesSince(const JulianTime& epoch) const {
+            return ((day - epoch.day) + (frac - epoch.frac)) * 1440.0;
+        }
+
+        // Greenwich mean sidereal time in radians (IAU 1982)
+        double gmst() const {
+            double T = (day - 2451545.0) / 36525.0;
+            double gmst_0h = 24110.54841 + 8640184.812866 * T + 0.093104 * T * T - 6.2e-6 * T * T * T;
+            double gmst_sec = gmst_0h + frac * 86400.0 * 1.00273790935;
+            gmst_sec = std::fmod(gmst_sec, 86400.0);
+            if (gmst_sec < 0) gmst_sec += 86400.0;
+            return (gmst_sec / 240.0) * (3.14159265358979323846 / 180.0);
+        }
+    };
+}
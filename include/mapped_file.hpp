@@ -0,0 +1,50 @@
+#pragma once
+#include <string>
+#include <string_view>
+#include <cstdint>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace ve {
+    // Read-only mapping of a whole file. The pages are shared with the OS
+    // cache, so readers parse in place without a copy into the heap.
+    class MappedFile {
+    public:
+        MappedFile() = default;
+        explicit MappedFile(const std::string& path) { open(path); }
+        ~MappedFile() { close(); }
+        MappedFile(const MappedFile&) = delete;
+        MappedFile& operator=(const MappedFile&) = delete;
+
+        // False if the file is missing, empty or cannot be mapped
+        bool open(const std::string& path) {
+            close();
+            int fd = ::open(path.c_str(), O_RDONLY);
+            if (fd < 0) return false;
+            struct stat st;
+            if (fstat(fd, &st) != 0 || st.st_size <= 0) { ::close(fd); return false; }
+            void* map = mmap(nullptr, st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            ::close(fd);     // The mapping keeps its own reference
+            if (map == MAP_FAILED) return false;
+            data_ = static_cast<const uint8_t*>(map);
+            size_ = static_cast<size_t>(st.st_size);
+            return true;
+        }
+        void close() {
+            if (data_) munmap(const_cast<uint8_t*>(data_), size_);
+            data_ = nullptr;
+            size_ = 0;
+        }
+
+        bool isOpen() const { return data_ != nullptr; }
+        const uint8_t* data() const { return data_; }
+        size_t size() const { return size_; }
+        std::string_view view() const { return {reinterpret_cast<const char*>(data_), size_}; }
+
+    private:
+        const uint8_t* data_ = nullptr;
+        size_t size_ = 0;
+    };
+}
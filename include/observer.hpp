@@ -2,6 +2,8 @@
 #include "types.hpp"
 
 namespace ve {
+    struct FrameContext;
+
     class Observer {
     public:
         struct LookAngle {
@@ -13,12 +15,18 @@ namespace ve {
         Observer(double lat, double lon, double alt);
         Geodetic getLocation() const { return location_; }
         Vector3 getPositionECI(const TimePoint& t) const;
+        Vector3 getPositionECI(double gmst) const;
         Vector3 getVelocityECI(const TimePoint& t) const;
         LookAngle calculateLookAngle(const Vector3& sat_eci, const TimePoint& t) const;
         double calculateRangeRate(const Vector3& sat_pos, const Vector3& sat_vel, const TimePoint& t) const;
 
+        // Per-tick variants: observer state and rotation come from the shared context
+        LookAngle calculateLookAngle(const Vector3& sat_eci, const FrameContext& ctx) const;
+        double calculateRangeRate(const Vector3& sat_pos, const Vector3& sat_vel, const FrameContext& ctx) const;
+
     private:
         Geodetic location_;
+        Vector3 ecf_;   // Fixed Earth-frame position, computed once
         double getGST(const TimePoint& t) const;
     };
 }
@@ -0,0 +1,69 @@
+#pragma once
+#include "satellite.hpp"
+#include "ephemeris.hpp"
+#include "config_manager.hpp"
+#include "mapped_file.hpp"
+#include <string>
+#include <vector>
+#include <cstdint>
+
+namespace ve {
+    // On-disk snapshot of the precalc results (pass records, reach class and
+    // Chebyshev ephemeris) so a restart with the same elements and observer
+    // skips the pass search. The file is a fixed header, an entry table sorted
+    // by (NORAD id, TLE hash), then flat pass and segment arrays; it is mapped
+    // read-only and entries are read in place. Everything in the header must
+    // match the running configuration, otherwise the whole file is ignored;
+    // entries whose elements changed or whose predictions run out too soon
+    // simply miss and are recomputed.
+    class PassCache {
+    public:
+        struct Key {
+            double lat, lon, alt;
+            double min_el;
+            double tolerance_km;    // Ephemeris fit tolerance (0 = no ephemeris)
+            bool operator==(const Key& o) const {
+                return lat == o.lat && lon == o.lon && alt == o.alt && min_el == o.min_el && tolerance_km == o.tolerance_km;
+            }
+            bool operator!=(const Key& o) const { return !(*this == o); }
+        };
+        // Everything besides the elements that the cached predictions depend on
+        static Key makeKey(const Geodetic& observer, const AppConfig& cfg) {
+            return {observer.lat_deg, observer.lon_deg, observer.alt_km, cfg.min_el, cfg.ephemeris_tolerance_km};
+        }
+        // A hit must still predict this far past now; the rolling horizon tops up the rest
+        static constexpr int MIN_AHEAD_MINS = 720;
+
+        explicit PassCache(std::string path) : path_(std::move(path)) {}
+        ~PassCache() { close(); }
+        PassCache(const PassCache&) = delete;
+        PassCache& operator=(const PassCache&) = delete;
+
+        // Maps the file; false if it is missing, truncated or was built for another key
+        bool open(const Key& key);
+        void close();
+        bool isOpen() const { return file_.isOpen(); }
+
+        // Restores the satellite's predictions if its entry is valid at now. The
+        // ephemeris must also cover the trail behind now.
+        bool restore(Satellite& sat, const TimePoint& now, int trail_mins) const;
+
+        // Writes the catalog's current predictions (temp file + rename, so a crash
+        // mid-write leaves the old cache intact)
+        static bool save(const std::string& path, const Key& key, const std::vector<Satellite>& sats);
+
+    private:
+        struct Header;
+        struct Entry;
+        struct PassData;
+
+        std::string path_;
+        MappedFile file_;
+        const Entry* entries_ = nullptr;
+        size_t entry_count_ = 0;
+        const PassData* passes_ = nullptr;
+        size_t pass_count_ = 0;
+        const ChebyshevEphemeris::Segment* segments_ = nullptr;
+        size_t segment_count_ = 0;
+    };
+}
@@ -0,0 +1,38 @@
+#pragma once
+#include "satellite.hpp"
+#include "celestial_body.hpp"
+#include "observer.hpp"
+#include "config_manager.hpp"
+#include "event_timeline.hpp"
+#include <vector>
+
+namespace ve {
+    // Rolling pass-prediction horizon. Precalc searches the first HORIZON_MINS
+    // of each satellite; afterwards step() runs once per tick and, round-robin over
+    // the catalog, extends every satellite whose predictions have fallen a chunk
+    // behind now + HORIZON_MINS by one CHUNK_MINS search. Work stops when the
+    // per-tick budget is spent, so the cost is spread evenly instead of landing
+    // as a blocking re-precalc. The ephemeris cache is refitted the same way
+    // before the pass search runs off its end.
+    class PassHorizon {
+    public:
+        static constexpr int HORIZON_MINS = 1440;
+        static constexpr int CHUNK_MINS = 60;
+
+        // Returns the number of satellites extended
+        int step(std::vector<Satellite>& sats, const Observer& obs, const AppConfig& cfg,
+                 const TimePoint& now, std::chrono::milliseconds budget);
+        // Call after the catalog is reloaded
+        void reset() { cursor_ = 0; }
+        // Sun/Moon rise and set, searched BODY_HORIZON_MINS ahead whenever less
+        // than HORIZON_MINS remains (a body with no events yet is searched at once)
+        static void stepBodies(std::vector<CelestialBody>& bodies, const Observer& obs, const TimePoint& now);
+        static constexpr int BODY_HORIZON_MINS = 2 * HORIZON_MINS;
+        // Snapshot every satellite's pass records into one catalog-wide timeline
+        static TimelinePtr buildTimeline(const std::vector<Satellite>& sats);
+
+    private:
+        void extend(Satellite& sat, const Observer& obs, const AppConfig& cfg, const TimePoint& now);
+        size_t cursor_ = 0;
+    };
+}
@@ -1,16 +1,45 @@
 #pragma once
 #include "satellite.hpp"
 #include "observer.hpp"
+#include "reach.hpp"
+#include "celestial_body.hpp"
+#include <functional>
 
 namespace ve {
     class PassPredictor {
     public:
-        PassPredictor(const Observer& obs);
+        // FIXED_STEP: legacy 2-minute scan with finite-difference Newton refinement.
+        // ADAPTIVE: step sized from an elevation-rate bound, Illinois root bracketing
+        // for AOS/LOS and Brent maximization for culmination.
+        enum class Mode { FIXED_STEP, ADAPTIVE };
+
+        PassPredictor(const Observer& obs, Mode mode = Mode::ADAPTIVE);
         std::vector<Satellite::PassEvent> predict(Satellite& sat, const TimePoint& start, int search_window_mins = 1440);
+        // ADAPTIVE search returning full pass records (horizon = 0 deg). A reach from
+        // classify() shortcuts the search: NEVER gives no passes, ALWAYS one pass
+        // spanning the window.
+        std::vector<Satellite::PassRecord> predictPasses(const Satellite& sat, const TimePoint& start, int search_window_mins = 1440,
+                                                         Reach reach = Reach::PASS_CAPABLE);
+        // NEVER if the satellite cannot reach min_el in the window, ALWAYS if it cannot
+        // set below the pass horizon. One propagation.
+        Reach classify(const Satellite& sat, const TimePoint& start, int search_window_mins, double min_el) const;
+        // Rise/culmination/set of the Sun or Moon (centre on the 0 deg horizon, no refraction)
+        std::vector<Satellite::PassRecord> predictPasses(const CelestialBody& body, const TimePoint& start, int search_window_mins = 2880);
 
     private:
         Observer observer_;
+        Mode mode_;
         double getElevation(const Satellite& sat, const TimePoint& t);
         TimePoint solveNewton(const Satellite& sat, TimePoint initial_guess);
+
+        // Adaptive helpers work in seconds from the search start
+        using LookFn = std::function<Observer::LookAngle(double)>;
+        using ElevationFn = std::function<double(double)>;
+        // Bracketing scan shared by satellites and bodies. rate_below bounds the
+        // elevation rate (deg/s) below the horizon, step_up is the step above it.
+        std::vector<Satellite::PassRecord> scanPasses(const TimePoint& start, double span, const LookFn& look,
+                                                      double rate_below, double step_up, bool always_up);
+        static double findCrossing(const ElevationFn& el, double a, double fa, double b, double fb);
+        static double findCulmination(const ElevationFn& el, double a, double b);
     };
 }
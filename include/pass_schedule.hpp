@@ -0,0 +1,66 @@
+#pragma once
+#include "types.hpp"
+#include <vector>
+
+namespace ve {
+    // AOS/LOS events of one satellite in a flat, time-sorted array with a
+    // forward-only cursor at the first event still in the future. Physics time
+    // only moves forward tick to tick, so next() usually costs a compare or
+    // two; when simulated time jumps (backwards, or past many events) it falls
+    // back to a binary search.
+    class PassSchedule {
+    public:
+        struct Event { TimePoint time; bool is_aos; };
+
+        // Events must be sorted by time
+        void assign(std::vector<Event> events) { events_ = std::move(events); cursor_ = 0; }
+        void clear() { events_.clear(); cursor_ = 0; }
+
+        // First event strictly after t, or nullptr
+        const Event* next(const TimePoint& t) {
+            size_t c = seek(t);
+            return (c < events_.size()) ? &events_[c] : nullptr;
+        }
+        // First AOS strictly after t, or nullptr
+        const Event* nextAos(const TimePoint& t) {
+            for (size_t c = seek(t); c < events_.size(); ++c) {
+                if (events_[c].is_aos) return &events_[c];
+            }
+            return nullptr;
+        }
+
+        const std::vector<Event>& events() const { return events_; }
+        size_t size() const { return events_.size(); }
+
+    private:
+        // Linear steps allowed before a jump is treated as a seek
+        static constexpr size_t MAX_STEPS = 4;
+
+        size_t seek(const TimePoint& t) {
+            size_t c = cursor_;
+            if (c > events_.size() || (c > 0 && events_[c - 1].time > t)) {
+                c = search(t);
+            } else {
+                size_t steps = 0;
+                while (c < events_.size() && events_[c].time <= t) {
+                    if (++steps > MAX_STEPS) { c = search(t); break; }
+                    ++c;
+                }
+            }
+            cursor_ = c;
+            return c;
+        }
+        size_t search(const TimePoint& t) const {
+            size_t lo = 0, hi = events_.size();
+            while (lo < hi) {
+                size_t mid = (lo + hi) / 2;
+                if (events_[mid].time <= t) lo = mid + 1;
+                else hi = mid;
+            }
+            return lo;
+        }
+
+        std::vector<Event> events_;
+        size_t cursor_ = 0;
+    };
+}
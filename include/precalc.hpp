@@ -0,0 +1,76 @@
+#pragma once
+#include "satellite.hpp"
+#include "observer.hpp"
+#include "config_manager.hpp"
+#include "pass_cache.hpp"
+#include "satellite_batch.hpp"
+#include "scheduler.hpp"
+#include <vector>
+#include <atomic>
+#include <memory>
+
+namespace ve {
+    // Background fill of the initial pass predictions, so the servers and the
+    // tick run from the first second. The catalog is ranked once at start, from
+    // one parallel batch propagation to the start time:
+    //   1. the selected satellite(s)
+    //   2. above the horizon now
+    //   3. below it but approaching (negative range rate), nearest the horizon first
+    //   4. everything else, nearest the horizon first
+    // and the shared scheduler's workers take satellites in that order between
+    // tick chunks, trying the pass cache before the full search. prioritize() moves a satellite to the front while the
+    // fill runs. Until a satellite's predictions land it reports
+    // hasPredictions() == false and the tick shows it as pending. Satellites
+    // that already have predictions (kept across a reload) are skipped.
+    class Precalc {
+    public:
+        // Results are restored from and saved to the pass cache at cache_path
+        Precalc(std::string cache_path, Scheduler& scheduler);
+        ~Precalc() { cancel(); }
+        Precalc(const Precalc&) = delete;
+        Precalc& operator=(const Precalc&) = delete;
+
+        // sats must not be moved or resized until the fill finishes or is cancelled.
+        // batch must be built from sats; it is propagated to now for the ranking.
+        void start(std::vector<Satellite>& sats, SatelliteBatch& batch, const Observer& obs, const AppConfig& cfg,
+                   const TimePoint& now, int selected_norad_id);
+        // Next worker to free up takes this satellite (no-op if already done)
+        void prioritize(int norad_id);
+        // Stops the fill and waits for satellites in progress; the rest stay pending
+        void cancel();
+
+        bool running() const { return remaining_.load() > 0; }
+        size_t completed() const { return completed_.load(); }
+        size_t total() const { return order_.size(); }
+        // Observer and settings the catalog's predictions were computed for (as
+        // of the last start); save the pass cache under this, not the live config
+        const PassCache::Key& key() const { return key_; }
+
+    private:
+        void rank(SatelliteBatch& batch, int selected_norad_id);
+        void next();
+        void process(size_t i);
+        void finish();
+        TimePoint physicsNow() const;
+
+        std::string cache_path_;
+        Scheduler& scheduler_;
+        std::unique_ptr<Scheduler::Pending> fill_;
+        std::vector<Satellite>* sats_ = nullptr;
+        std::unique_ptr<Observer> obs_;
+        AppConfig cfg_;
+        TimePoint start_time_{};
+        std::chrono::steady_clock::time_point started_{};
+        std::unique_ptr<PassCache> cache_;
+        PassCache::Key key_{};
+
+        std::vector<size_t> order_;                         // Catalog indices, highest priority first
+        std::unique_ptr<std::atomic<bool>[]> claimed_;      // Per catalog index
+        std::atomic<size_t> cursor_{0};
+        std::atomic<int> urgent_{0};
+        std::atomic<size_t> completed_{0};
+        std::atomic<size_t> restored_{0};
+        std::atomic<size_t> remaining_{0};                  // Fill items not yet run
+        std::atomic<bool> cancel_{false};
+    };
+}
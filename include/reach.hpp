@@ -0,0 +1,19 @@
+#pragma once
+#include "types.hpp"
+#include "sgp4_kernel.hpp"
+
+namespace ve {
+    // Analytic reachability of an orbit for one observer, from mean elements only.
+    // NEVER: the orbit cannot bring the satellite above the mask during the window.
+    // ALWAYS: it cannot take it below the mask (near-synchronous objects parked above).
+    // PASS_CAPABLE: anything else; needs a real pass search.
+    // Both definite classes carry safety margins, so a borderline orbit is always
+    // reported as PASS_CAPABLE.
+    enum class Reach { NEVER, PASS_CAPABLE, ALWAYS };
+
+    // el_now_deg is the current elevation, only used for near-synchronous orbits
+    Reach classifyReach(const Sgp4Elements& el, const Geodetic& observer, double mask_deg,
+                        double window_mins, double el_now_deg);
+
+    const char* reachName(Reach r);
+}
@@ -0,0 +1,61 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <algorithm>
+#include <cstddef>
+
+namespace ve {
+    // Display ordering. Each key maps a candidate to a score where lower sorts
+    // first; equal scores fall back to catalog index, so the order is total and
+    // rows do not swap places between ticks (the old stable_sort behaviour).
+    enum class SortKey {
+        ELEVATION,  // Highest first
+        RANGE,      // Nearest first
+        NEXT_AOS,   // Up now (by elevation), then soonest rise
+        FLARE       // Flare hit, near, then by elevation
+    };
+    SortKey parseSortKey(const std::string& name);    // "el", "range", "aos", "flare"; anything else = el
+    const char* sortKeyName(SortKey key);
+
+    struct Candidate {
+        double key;
+        size_t index;
+    };
+    inline bool sortsBefore(const Candidate& a, const Candidate& b) {
+        return a.key < b.key || (a.key == b.key && a.index < b.index);
+    }
+
+    // Bounded selection of the k best candidates: a max-heap on sortsBefore, so
+    // the worst kept candidate sits on top and is the only one compared against.
+    // O(n log k) and O(k) memory instead of sorting everything.
+    class TopK {
+    public:
+        explicit TopK(size_t k = 0) { reset(k); }
+        void reset(size_t k) { k_ = k; heap_.clear(); heap_.reserve(k); }
+
+        void offer(const Candidate& c) {
+            if (k_ == 0) return;
+            if (heap_.size() < k_) {
+                heap_.push_back(c);
+                std::push_heap(heap_.begin(), heap_.end(), sortsBefore);
+            } else if (sortsBefore(c, heap_.front())) {
+                std::pop_heap(heap_.begin(), heap_.end(), sortsBefore);
+                heap_.back() = c;
+                std::push_heap(heap_.begin(), heap_.end(), sortsBefore);
+            }
+        }
+
+        const std::vector<Candidate>& items() const { return heap_; }   // Heap order
+        // Best first; leaves the selector empty
+        std::vector<Candidate> takeSorted() {
+            std::sort_heap(heap_.begin(), heap_.end(), sortsBefore);
+            std::vector<Candidate> out;
+            out.swap(heap_);
+            return out;
+        }
+
+    private:
+        size_t k_ = 0;
+        std::vector<Candidate> heap_;
+    };
+}
@@ -1,49 +1,149 @@
 #pragma once
 #include "types.hpp"
+#include "sgp4_kernel.hpp"
+#include "element_store.hpp"
+#include "ground_track.hpp"
+#include "reach.hpp"
+#include "pass_schedule.hpp"
 #include <string>
+#include <string_view>
 #include <vector>
 #include <memory>
 #include <deque>
 #include <atomic>
 #include <mutex>
+#include <cstdint>
 #include <Tle.h>
 #include <SGP4.h>
 #include <Eci.h>
 
 namespace ve {
+    class ChebyshevEphemeris;
+
+    // Why an object is or is not propagated. Anything but NOMINAL is quarantined:
+    // classified once, at load or at the first propagation failure, and from
+    // then on skipped by every propagation path instead of failing (and, in
+    // libsgp4, throwing) again on each call.
+    enum class TrackStatus : uint8_t { NOMINAL, DECAYED, INVALID_ELEMENTS, SYNTHETIC };
+
+    const char* trackStatusName(TrackStatus s);
+
     class Satellite {
     public:
-        Satellite(std::string name, std::string line1, std::string line2);
+        // Element set in slot of a shared store (see ElementStore)
+        Satellite(std::shared_ptr<const ElementStore> store, size_t slot);
+        // Standalone element set, parsed into a store of its own
+        Satellite(std::string_view name, std::string_view line1, std::string_view line2);
         Satellite(Satellite&& other) noexcept;
         Satellite(const Satellite&) = delete;
         Satellite& operator=(const Satellite&) = delete;
 
         std::pair<Vector3, Vector3> propagate(const TimePoint& t) const;
         Geodetic getGeodetic(const TimePoint& t) const;
+        // State at minutes since TLE epoch: served from the ephemeris cache when it
+        // covers tsince, otherwise a direct libsgp4 call
+        std::pair<Vector3, Vector3> propagateMinutes(double tsince) const;
+        // Always libsgp4 (used to fit and verify the cache)
+        std::pair<Vector3, Vector3> propagateSgp4(double tsince) const;
+        // Mean elements, near-earth constants and derived orbit, computed once per element set
+        const ElementRecord& getRecord() const { return *rec_; }
+        // Mean elements in SGP4 units for the batch engine
+        const Sgp4Elements& getSgp4Elements() const { return rec_->elements; }
+        const JulianTime& getEpoch() const { return rec_->epoch; }
 
-        const std::string& getName() const { return name_; }
-        int getNoradId() const { return norad_id_; }
+        std::string_view getName() const { return store_->name(slot_); }
+        std::string_view getLine1() const { return store_->line1(slot_); }
+        std::string_view getLine2() const { return store_->line2(slot_); }
+        int getNoradId() const { return rec_->norad_id; }
+        // FNV-1a of the two element lines; identifies the exact element set
+        uint64_t getTleHash() const { return rec_->tle_hash; }
         int getTleEpochYear() const;
         double getTleEpochDay() const;
-        double getApogeeKm() const;
+        double getApogeeKm() const { return rec_->apogee_km; }
+        double getPerigeeKm() const { return rec_->perigee_km; }
+        double getPeriodMinutes() const { return rec_->period_min; }
+
+        TrackStatus getStatus() const { return status_.load(std::memory_order_relaxed); }
+        bool isQuarantined() const { return getStatus() != TrackStatus::NOMINAL; }
+        // Records the first failure; later calls keep the original reason
+        void quarantine(TrackStatus reason) const;
 
+        // Fills the record of slot from the text already set there (thread safe
+        // across distinct slots); false if libsgp4 rejects the element set
+        static bool deriveRecord(ElementStore& store, size_t slot);
+        // Switches to other's copy of the same element set (equal hash), so the
+        // store this one came from can be freed; state is untouched
+        void adoptElements(const Satellite& other);
+
+        // Full rebuild of the +/- half_width trail (step_secs is the sparsest sampling)
         void calculateGroundTrack(const TimePoint& now, int half_width_mins, int step_secs = 60);
+        // Incremental: expire old samples and append newly due ones
+        void advanceGroundTrack(const TimePoint& now);
         std::vector<Geodetic> getFullTrackCopy() const;
 
-        struct PassEvent { TimePoint time; bool is_aos; };
+        using PassEvent = PassSchedule::Event;
         void setPredictedPasses(const std::vector<PassEvent>& passes);
         std::vector<PassEvent> getPredictedPasses() const;
+        // First predicted event / AOS after t via the schedule cursor (no copy, O(1) tick to tick)
+        bool getNextEvent(const TimePoint& t, PassEvent& event) const;
+        bool getNextAos(const TimePoint& t, TimePoint& aos) const;
+
+        // Full pass: rise, culmination and set. A pass already in progress at the
+        // start of the search has has_aos = false (aos = search start); one still
+        // in progress at the end has has_los = false (los = search end).
+        struct PassRecord {
+            TimePoint aos, tca, los;
+            double max_el;
+            double aos_az, tca_az, los_az;
+            bool has_aos, has_los;
+        };
+        // Stores the records (searched up to 'until') and derives the AOS/LOS event list
+        void setPassRecords(const std::vector<PassRecord>& passes, const TimePoint& until);
+        // Rolling horizon: append the passes found in [getPredictedUntil(), until),
+        // joining a pass split at the seam, and drop passes that set before now
+        void extendPassRecords(const std::vector<PassRecord>& chunk, const TimePoint& until, const TimePoint& now);
+        std::vector<PassRecord> getPassRecords() const;
+        // Drops the records, events and reach class (e.g. the observer moved);
+        // the satellite reports hasPredictions() == false until searched again
+        void clearPredictions();
+        TimePoint getPredictedUntil() const;
+        // False until the first pass search (or cache restore) has landed
+        bool hasPredictions() const { return getPredictedUntil() != TimePoint{}; }
+        // Analytic reach class from the last pass prediction
+        void setReach(Reach r) { reach_.store(r); }
+        Reach getReach() const { return reach_.load(); }
+
+        // Optional Chebyshev cache, swapped atomically so readers never lock.
+        // fitEphemeris covers [start, start + horizon) and returns null on failure.
+        std::shared_ptr<const ChebyshevEphemeris> fitEphemeris(const TimePoint& start, double horizon_mins, double tolerance_km) const;
+        void setEphemeris(std::shared_ptr<const ChebyshevEphemeris> eph);
+        std::shared_ptr<const ChebyshevEphemeris> getEphemeris() const;
 
         std::atomic<bool> is_computing;
 
     private:
-        std::string name_;
-        int norad_id_;
-        std::unique_ptr<libsgp4::Tle> tle_object_;
-        std::unique_ptr<libsgp4::SGP4> sgp4_object_;
+        std::shared_ptr<const ElementStore> store_;
+        const ElementRecord* rec_ = nullptr;
+        uint32_t slot_ = 0;
+        // Built on first libsgp4 propagation (deep space, ephemeris fits); guarded by sat_mutex_
+        mutable std::unique_ptr<libsgp4::Tle> tle_object_;
+        mutable std::unique_ptr<libsgp4::SGP4> sgp4_object_;
+        mutable bool sgp4_failed_ = false;
+        mutable std::atomic<TrackStatus> status_{TrackStatus::NOMINAL};
         // Mutex for thread-safe access to SGP4 and cached data
         mutable std::mutex sat_mutex_;
-        std::vector<Geodetic> full_track_; 
-        std::vector<PassEvent> predicted_passes_;
+        // Separate lock: sampling the track propagates, which may take sat_mutex_
+        mutable std::mutex track_mutex_;
+        GroundTrack ground_track_;
+        mutable PassSchedule schedule_;     // Cursor moves on lookups; guarded by sat_mutex_
+        std::vector<PassRecord> pass_records_;
+        TimePoint predicted_until_{};
+        std::atomic<Reach> reach_{Reach::PASS_CAPABLE};
+        std::shared_ptr<const ChebyshevEphemeris> ephemeris_;
+
+        GroundTrack::Sampler trackSampler() const;
+        void classify();            // Initial status from the element record
+        bool ensureSgp4() const;    // Caller holds sat_mutex_
+        void rebuildPassEvents();   // Caller holds sat_mutex_
     };
 }
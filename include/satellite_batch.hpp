@@ -0,0 +1,61 @@
+#pragma once
+#include "types.hpp"
+#include "sgp4_kernel.hpp"
+#include "satellite.hpp"
+#include <vector>
+#include <cstdint>
+
+namespace ve {
+    // Structure-of-arrays SGP4 engine for the whole catalog.
+    // Near-earth constants are copied in once by build() (each Satellite derives
+    // them on construction or takes them from the binary catalog) and every
+    // object is propagated to one epoch in a single branch-free pass that the
+    // compiler can vectorize (AVX2 / NEON). Deep-space objects (period >= 225 min) fall back
+    // to their libsgp4 instance, skipping the calendar round trip.
+    // Index i of the batch always refers to sats[i] of the vector it was built from.
+    class SatelliteBatch {
+    public:
+        void build(const std::vector<Satellite>& sats);
+        void clear();
+
+        // Propagate every object (or the [begin, end) slice) to t
+        void propagate(const TimePoint& t);
+        void propagate(const TimePoint& t, size_t begin, size_t end);
+
+        size_t size() const { return count_; }
+        size_t deepSpaceCount() const { return deep_index_.size(); }
+
+        Vector3 position(size_t i) const { return {px_[i], py_[i], pz_[i]}; }
+        Vector3 velocity(size_t i) const { return {vx_[i], vy_[i], vz_[i]}; }
+        uint8_t status(size_t i) const { return status_[i]; }
+        bool ok(size_t i) const { return status_[i] == SGP4_OK; }
+        // Position lanes for the SoA kernels (visibility, flares)
+        const double* px() const { return px_.data(); }
+        const double* py() const { return py_.data(); }
+        const double* pz() const { return pz_.data(); }
+
+    private:
+        std::vector<std::vector<double>*> lanes();
+        void propagateNear(const JulianTime& jt, size_t begin, size_t end);
+        void propagateDeep(const JulianTime& jt, size_t begin, size_t end);
+
+        const std::vector<Satellite>* sats_ = nullptr;
+        size_t count_ = 0;
+
+        // Near-earth constants, one lane per object
+        std::vector<double> epoch_day_, epoch_frac_;   // Split TLE epoch (see JulianTime)
+        std::vector<double> mean_anomaly_, arg_perigee_, raan_, inclination_, eccentricity_, bstar_;
+        std::vector<double> aodp_, xnodp_;
+        std::vector<double> cosio_, sinio_, eta_, c1_, c4_, c5_;
+        std::vector<double> x1mth2_, x3thm1_, x7thm1_, xlcof_, aycof_;
+        std::vector<double> xmdot_, omgdot_, xnodot_, xnodcf_, t2cof_;
+        std::vector<double> omgcof_, xmcof_, delmo_, sinmo_;
+        std::vector<double> d2_, d3_, d4_, t3cof_, t4cof_, t5cof_;
+        std::vector<uint8_t> model_;        // Sgp4Model per object
+        std::vector<size_t> deep_index_;    // Sorted indices of DEEP_SPACE objects
+
+        // Output state (TEME, km and km/s)
+        std::vector<double> px_, py_, pz_, vx_, vy_, vz_;
+        std::vector<uint8_t> status_;
+    };
+}
@@ -0,0 +1,282 @@
+#pragma once
+#include <vector>
+#include <deque>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
+#include <functional>
+#include <atomic>
+#include <chrono>
+#include <exception>
+#include <memory>
+#include <type_traits>
+#include <algorithm>
+
+namespace ve {
+    // Counts down to zero once; waiters can time out to report progress.
+    class Latch {
+    public:
+        explicit Latch(size_t count) : count_(count) {}
+        void countDown(size_t n = 1) {
+            std::lock_guard<std::mutex> lock(mutex_);
+            count_ -= n;
+            if (count_ == 0) cv_.notify_all();
+        }
+        bool done() const {
+            std::lock_guard<std::mutex> lock(mutex_);
+            return count_ == 0;
+        }
+        void wait() {
+            std::unique_lock<std::mutex> lock(mutex_);
+            cv_.wait(lock, [this] { return count_ == 0; });
+        }
+        // True if the latch reached zero within the timeout
+        template<class Rep, class Period>
+        bool waitFor(const std::chrono::duration<Rep, Period>& timeout) {
+            std::unique_lock<std::mutex> lock(mutex_);
+            return cv_.wait_for(lock, timeout, [this] { return count_ == 0; });
+        }
+    private:
+        mutable std::mutex mutex_;
+        std::condition_variable cv_;
+        size_t count_;
+    };
+
+    // Work-stealing pool for index-range loops. parallel_for splits [0, n) into
+    // grain-sized chunks dealt out in contiguous blocks to per-worker deques.
+    // Workers pop their own deque from the back and steal from the front of
+    // the others, so neighbouring indices stay on one thread until the load
+    // runs uneven. Chunks are plain {job, begin, end} records: no allocation
+    // per task and no shared queue lock. The calling thread steals too while
+    // it waits, which also makes nested calls from a worker safe.
+    class Scheduler {
+    public:
+        // 0 = one worker per hardware thread, less the caller, which also works
+        explicit Scheduler(size_t threads = 0) {
+            if (threads == 0) {
+                size_t hw = std::thread::hardware_concurrency();
+                threads = (hw > 1) ? hw - 1 : 1;
+            }
+            queues_.reserve(threads);
+            for (size_t i = 0; i < threads; ++i) queues_.push_back(std::make_unique<Queue>());
+            for (size_t i = 0; i < threads; ++i) workers_.emplace_back([this, i] { workerLoop(i); });
+        }
+        ~Scheduler() {
+            {
+                std::lock_guard<std::mutex> lock(sleep_mutex_);
+                stop_ = true;
+            }
+            sleep_cv_.notify_all();
+            for (auto& w : workers_) w.join();
+        }
+        Scheduler(const Scheduler&) = delete;
+        Scheduler& operator=(const Scheduler&) = delete;
+
+        size_t size() const { return workers_.size(); }
+
+        // body(begin, end) over [0, n); blocks until every chunk has run and
+        // rethrows the first exception a chunk threw
+        template<class F>
+        void parallel_for(size_t n, size_t grain, F&& body) {
+            parallel_for(n, grain, std::forward<F>(body), [](size_t) {}, std::chrono::milliseconds(0));
+        }
+
+        // As above, calling progress(items_done) on the calling thread every interval
+        template<class F, class P>
+        void parallel_for(size_t n, size_t grain, F&& body, P&& progress, std::chrono::milliseconds interval) {
+            if (n == 0) return;
+            if (grain == 0) grain = 1;
+            using Body = typename std::remove_reference<F>::type;
+            Job job(n);
+            job.ctx = const_cast<void*>(static_cast<const void*>(&body));
+            job.invoke = [](void* ctx, size_t b, size_t e) { (*static_cast<Body*>(ctx))(b, e); };
+
+            // 1. Deal contiguous blocks of chunks to the worker deques. The count is
+            // published first so a pop can never run ahead of it.
+            enqueue(job, n, grain);
+
+            // 2. Help until the deques run dry, then wait for chunks still in flight.
+            // Background (submitted) chunks are never taken here, so a loop only
+            // waits for its own chunks and those other workers already started.
+            auto last_report = std::chrono::steady_clock::now();
+            Task t;
+            while (steal(queues_.size(), t)) {
+                run(t);
+                if (interval.count() > 0 && std::chrono::steady_clock::now() - last_report >= interval) {
+                    progress(job.items_done.load());
+                    last_report = std::chrono::steady_clock::now();
+                }
+            }
+            if (interval.count() > 0) {
+                while (!job.latch.waitFor(interval)) progress(job.items_done.load());
+                progress(n);
+            } else {
+                job.latch.wait();
+            }
+            if (job.error) std::rethrow_exception(job.error);
+        }
+
+        // Background loop: body(begin, end) over [0, n) returns at once. Its chunks
+        // sit in a separate FIFO that workers drain only when the deques are
+        // empty, and that parallel_for callers never help with, so a
+        // parallel_for waits behind at most one background chunk per worker.
+        // The handle owns the body; wait() (also run by its destructor) helps
+        // with its own remaining chunks and blocks until every one has run.
+        class Pending;
+        template<class F>
+        std::unique_ptr<Pending> submit(size_t n, size_t grain, F body);
+
+    private:
+        struct Job {
+            explicit Job(size_t n) : latch(n) {}
+            void (*invoke)(void*, size_t, size_t) = nullptr;
+            void* ctx = nullptr;
+            Latch latch;                        // Counts items, not chunks
+            std::atomic<size_t> items_done{0};
+            std::mutex error_mutex;
+            std::exception_ptr error;
+        };
+        struct Task { Job* job = nullptr; size_t begin = 0, end = 0; };
+        struct Queue {
+            std::mutex mutex;
+            std::deque<Task> tasks;
+        };
+
+        bool popLocal(size_t self, Task& t) {
+            Queue& q = *queues_[self];
+            std::lock_guard<std::mutex> lock(q.mutex);
+            if (q.tasks.empty()) return false;
+            t = q.tasks.back();
+            q.tasks.pop_back();
+            queued_--;
+            return true;
+        }
+
+        // self == queues_.size() means the caller thread (no own deque)
+        bool steal(size_t self, Task& t) {
+            size_t count = queues_.size();
+            for (size_t k = 1; k <= count; ++k) {
+                size_t victim = (self + k) % count;
+                if (victim == self) continue;
+                Queue& q = *queues_[victim];
+                std::lock_guard<std::mutex> lock(q.mutex);
+                if (q.tasks.empty()) continue;
+                t = q.tasks.front();
+                q.tasks.pop_front();
+                queued_--;
+                return true;
+            }
+            return false;
+        }
+
+        static void run(const Task& t) {
+            Job& job = *t.job;
+            try {
+                job.invoke(job.ctx, t.begin, t.end);
+            } catch (...) {
+                std::lock_guard<std::mutex> lock(job.error_mutex);
+                if (!job.error) job.error = std::current_exception();
+            }
+            size_t items = t.end - t.begin;
+            job.items_done += items;
+            job.latch.countDown(items);
+        }
+
+        void workerLoop(size_t self) {
+            for (;;) {
+                Task t;
+                if (popLocal(self, t) || steal(self, t) || popBackground(t, nullptr)) {
+                    run(t);
+                    continue;
+                }
+                std::unique_lock<std::mutex> lock(sleep_mutex_);
+                sleep_cv_.wait(lock, [this] { return stop_ || queued_.load() > 0; });
+                if (stop_ && queued_.load() == 0) return;
+            }
+        }
+
+        // only: take the first chunk of that job (nullptr: any chunk)
+        bool popBackground(Task& t, const Job* only) {
+            std::lock_guard<std::mutex> lock(background_mutex_);
+            auto it = background_.begin();
+            if (only) it = std::find_if(background_.begin(), background_.end(), [only](const Task& b) { return b.job == only; });
+            if (it == background_.end()) return false;
+            t = *it;
+            background_.erase(it);
+            queued_--;
+            return true;
+        }
+
+        void enqueueBackground(Job& job, size_t n, size_t grain) {
+            size_t chunks = (n + grain - 1) / grain;
+            {
+                std::lock_guard<std::mutex> lock(sleep_mutex_);
+                queued_ += chunks;
+            }
+            {
+                std::lock_guard<std::mutex> lock(background_mutex_);
+                for (size_t b = 0; b < n; b += grain) background_.push_back({&job, b, std::min(b + grain, n)});
+            }
+            sleep_cv_.notify_all();
+        }
+
+        void enqueue(Job& job, size_t n, size_t grain) {
+            size_t chunks = (n + grain - 1) / grain;
+            size_t per_queue = (chunks + queues_.size() - 1) / queues_.size();
+            {
+                std::lock_guard<std::mutex> lock(sleep_mutex_);
+                queued_ += chunks;
+            }
+            for (size_t q = 0, c = 0; q < queues_.size() && c < chunks; ++q) {
+                std::lock_guard<std::mutex> lock(queues_[q]->mutex);
+                for (size_t k = 0; k < per_queue && c < chunks; ++k, ++c) {
+                    size_t b = c * grain;
+                    queues_[q]->tasks.push_back({&job, b, std::min(b + grain, n)});
+                }
+            }
+            sleep_cv_.notify_all();
+        }
+
+        std::vector<std::unique_ptr<Queue>> queues_;
+        std::vector<std::thread> workers_;
+        std::mutex background_mutex_;
+        std::deque<Task> background_;       // Submitted chunks, oldest first
+        std::atomic<size_t> queued_{0};     // Chunks sitting in any deque or the background FIFO
+        std::mutex sleep_mutex_;
+        std::condition_variable sleep_cv_;
+        bool stop_ = false;
+    };
+
+    class Scheduler::Pending {
+    public:
+        ~Pending() { wait(); }
+        Pending(const Pending&) = delete;
+        Pending& operator=(const Pending&) = delete;
+
+        bool done() const { return job_.latch.done(); }
+        void wait() {
+            Task t;
+            while (!job_.latch.done() && pool_.popBackground(t, &job_)) run(t);
+            job_.latch.wait();
+        }
+
+    private:
+        friend class Scheduler;
+        Pending(Scheduler& pool, size_t n, std::function<void(size_t, size_t)> body)
+            : pool_(pool), job_(n), body_(std::move(body)) {
+            job_.ctx = &body_;
+            job_.invoke = [](void* ctx, size_t b, size_t e) { (*static_cast<std::function<void(size_t, size_t)>*>(ctx))(b, e); };
+        }
+
+        Scheduler& pool_;
+        Job job_;
+        std::function<void(size_t, size_t)> body_;
+    };
+
+    template<class F>
+    std::unique_ptr<Scheduler::Pending> Scheduler::submit(size_t n, size_t grain, F body) {
+        std::unique_ptr<Pending> pending(new Pending(*this, n, std::move(body)));
+        if (n > 0) enqueueBackground(pending->job_, n, grain == 0 ? 1 : grain);
+        return pending;
+    }
+}
@@ -0,0 +1,221 @@
+#pragma once
+#include <cmath>
+#include <cstdint>
+
+// The batch pass only vectorizes if the kernel is inlined into its loop
+#if defined(__GNUC__)
+#define VE_FORCE_INLINE inline __attribute__((always_inline))
+#else
+#define VE_FORCE_INLINE inline
+#endif
+
+namespace ve {
+    // WGS-72 constants used by SGP4 (identical to libsgp4's Globals.h)
+    constexpr double SGP4_XKMPER = 6378.135;
+    constexpr double SGP4_MU = 398600.8;
+    constexpr double SGP4_XJ2 = 1.082616e-3;
+    constexpr double SGP4_XJ3 = -2.53881e-6;
+    constexpr double SGP4_XJ4 = -1.65597e-6;
+    constexpr double SGP4_CK2 = 0.5 * SGP4_XJ2;
+    constexpr double SGP4_CK4 = -0.375 * SGP4_XJ4;
+    constexpr double SGP4_TWOPI = 6.28318530717958647692;
+    constexpr double SGP4_MINUTES_PER_DAY = 1440.0;
+
+    // Mean elements as read from a TLE, in SGP4 units (radians, radians/minute)
+    struct Sgp4Elements {
+        double epoch_jd;
+        double inclination;
+        double raan;
+        double eccentricity;
+        double arg_perigee;
+        double mean_anomaly;
+        double mean_motion;
+        double bstar;
+    };
+
+    // Near-earth constants produced once by initSgp4().
+    // The "simple" drag model (perigee < 220 km) is folded in by zeroing the
+    // higher order terms, so one branch-free code path serves every object.
+    struct Sgp4NearEarth {
+        double epoch_jd;
+        double mean_anomaly, arg_perigee, raan, inclination, eccentricity, bstar;
+        double aodp, xnodp;
+        double cosio, sinio, eta, c1, c4, c5;
+        double x1mth2, x3thm1, x7thm1, xlcof, aycof;
+        double xmdot, omgdot, xnodot, xnodcf, t2cof;
+        double omgcof, xmcof, delmo, sinmo;
+        double d2, d3, d4, t3cof, t4cof, t5cof;
+    };
+
+    enum class Sgp4Model : uint8_t { NEAR_EARTH, DEEP_SPACE, INVALID };
+
+    // Propagation status (reported instead of thrown on the hot path)
+    enum Sgp4Status : uint8_t { SGP4_OK = 0, SGP4_ERROR = 1, SGP4_DECAYED = 2 };
+
+    // Recovers the original mean motion / semi-major axis and fills the near-earth
+    // constants. Objects with a period >= 225 min are reported as DEEP_SPACE and
+    // must be propagated by libsgp4 (SDP4).
+    Sgp4Model initSgp4(const Sgp4Elements& el, Sgp4NearEarth& c);
+
+    // Fixed iteration count for Kepler's equation. The second order update
+    // converges to machine precision within 4 steps for near-earth eccentricities
+    // (e < 0.6); a fixed count keeps the loop free of data-dependent exits so the
+    // batch pass can vectorize.
+    constexpr int SGP4_KEPLER_ITERATIONS = 5;
+
+    // Branch-free sin/cos pair: Cody-Waite reduction to |z| <= pi/4 followed by
+    // the Cephes minimax polynomials (within 1 ulp for |x| < 1e5). Used instead
+    // of std::sin/std::cos because GCC fuses same-argument pairs into a scalar
+    // sincos() call, which has no vector variant and blocks the batch loop.
+    VE_FORCE_INLINE void sincosKernel(double x, double& s, double& c) {
+        const double TWO_OVER_PI = 0.63661977236758134308;
+        const double DP1 = 1.57079625129699707031;     // pi/2 split in three parts
+        const double DP2 = 7.54978941586159635335e-8;
+        const double DP3 = 5.39030285815811905290e-15;
+        const double k = std::floor(x * TWO_OVER_PI + 0.5);
+        const double z = ((x - k * DP1) - k * DP2) - k * DP3;
+        const double zz = z * z;
+        const double ps = z + z * zz * (((((1.58962301576546568060e-10 * zz - 2.50507477628578072866e-8) * zz
+                            + 2.75573136213857245213e-6) * zz - 1.98412698295895385996e-4) * zz
+                            + 8.33333333332211858878e-3) * zz - 1.66666666666666307295e-1);
+        const double pc = 1.0 - 0.5 * zz + zz * zz * (((((-1.13585365213876817300e-11 * zz + 2.08757008419747316778e-9) * zz
+                            - 2.75573141792967388112e-7) * zz + 2.48015872888517045348e-5) * zz
+                            - 1.38888888888730564116e-3) * zz + 4.16666666666665929218e-2);
+        // Quadrant kept in double: AVX2 has no packed int64 <-> double conversion
+        const double q = k - 4.0 * std::floor(k * 0.25);
+        const bool swap = (q == 1.0 || q == 3.0);
+        const double sv = swap ? pc : ps;
+        const double cv = swap ? ps : pc;
+        s = (q >= 2.0) ? -sv : sv;
+        c = (q == 1.0 || q == 2.0) ? -cv : cv;
+    }
+
+    // Near-earth SGP4 for one object. tsince in minutes from epoch.
+    // Output is TEME position (km) and velocity (km/s); zeroed on failure.
+    VE_FORCE_INLINE uint8_t propagateNearEarth(const Sgp4NearEarth& c, double tsince,
+                                      double& px, double& py, double& pz,
+                                      double& vx, double& vy, double& vz) {
+        const double xke = 0.0743669161331734132; // 60 / sqrt(XKMPER^3 / MU)
+
+        // 1. Secular gravity and atmospheric drag
+        const double xmdf = c.mean_anomaly + c.xmdot * tsince;
+        const double omgadf = c.arg_perigee + c.omgdot * tsince;
+        const double xnoddf = c.raan + c.xnodot * tsince;
+        const double tsq = tsince * tsince;
+        const double tcube = tsq * tsince;
+        const double tfour = tsince * tcube;
+        const double xnode = xnoddf + c.xnodcf * tsq;
+
+        const double delomg = c.omgcof * tsince;
+        double sinmdf, cosmdf;
+        sincosKernel(xmdf, sinmdf, cosmdf);
+        const double q = 1.0 + c.eta * cosmdf;
+        const double delm = c.xmcof * (q * q * q - c.delmo);
+        const double xmp = xmdf + delomg + delm;
+        const double omega = omgadf - delomg - delm;
+
+        const double tempa = 1.0 - c.c1 * tsince - c.d2 * tsq - c.d3 * tcube - c.d4 * tfour;
+        double sinmp, cosmp;
+        sincosKernel(xmp, sinmp, cosmp);
+        const double tempe = c.bstar * c.c4 * tsince + c.bstar * c.c5 * (sinmp - c.sinmo);
+        const double templ = c.t2cof * tsq + c.t3cof * tcube + tfour * (c.t4cof + tsince * c.t5cof);
+
+        const double a = c.aodp * tempa * tempa;
+        const double e_raw = c.eccentricity - tempe;
+        const double xl = xmp + omega + xnode + c.xnodp * templ;
+        bool failed = (e_raw <= -0.001);
+        // Ternaries rather than std::min/max: those return references, which leaves
+        // a pointer select in the loop that blocks vectorization.
+        const double e = (e_raw < 1.0e-6) ? 1.0e-6 : ((e_raw > 1.0 - 1.0e-6) ? 1.0 - 1.0e-6 : e_raw);
+
+        // 2. Long period periodics
+        const double xn = xke / (a * std::sqrt(a));
+        double sinomg, cosomg;
+        sincosKernel(omega, sinomg, cosomg);
+        const double axn = e * cosomg;
+        const double temp11 = 1.0 / (a * (1.0 - e * e));
+        const double xlt = xl + temp11 * c.xlcof * axn;
+        const double ayn = e * sinomg + temp11 * c.aycof;
+        const double elsq = axn * axn + ayn * ayn;
+        failed |= (elsq >= 1.0);
+
+        // 3. Kepler's equation
+        double capu = xlt - xnode;
+        capu -= SGP4_TWOPI * std::floor(capu / SGP4_TWOPI);
+        const double max_step = 1.25 * std::sqrt(elsq);
+        double epw = capu;
+        double sinepw = 0.0, cosepw = 1.0, ecose = 0.0, esine = 0.0;
+        // Fully unrolled: the vectorizer rejects loops nested in the batch loop
+#if defined(__GNUC__)
+#pragma GCC unroll 8
+#endif
+        for (int i = 0; i < SGP4_KEPLER_ITERATIONS; ++i) {
+            sincosKernel(epw, sinepw, cosepw);
+            ecose = axn * cosepw + ayn * sinepw;
+            esine = axn * sinepw - ayn * cosepw;
+            const double f = capu - epw + esine;
+            const double fdot = 1.0 - ecose;
+            double delta = f / fdot;
+            if (i == 0) delta = (delta > max_step) ? max_step : ((delta < -max_step) ? -max_step : delta);
+            else delta = f / (fdot + 0.5 * esine * delta);
+            epw += delta;
+        }
+
+        // 4. Short period periodics
+        const double temp21 = 1.0 - elsq;
+        const double pl = a * temp21;
+        failed |= (pl < 0.0);
+        const double r = a * (1.0 - ecose);
+        const double temp31 = 1.0 / r;
+        const double rdot = xke * std::sqrt(a) * esine * temp31;
+        const double rfdot = xke * std::sqrt(pl > 0.0 ? pl : 0.0) * temp31;
+        const double temp32 = a * temp31;
+        const double betal = std::sqrt(temp21 > 0.0 ? temp21 : 0.0);
+        const double temp33 = 1.0 / (1.0 + betal);
+        double cosu = temp32 * (cosepw - axn + ayn * esine * temp33);
+        double sinu = temp32 * (sinepw - ayn - axn * esine * temp33);
+        const double inv_u = 1.0 / std::sqrt(sinu * sinu + cosu * cosu);
+        cosu *= inv_u;
+        sinu *= inv_u;
+        const double sin2u = 2.0 * sinu * cosu;
+        const double cos2u = 2.0 * cosu * cosu - 1.0;
+
+        const double temp41 = 1.0 / pl;
+        const double temp42 = SGP4_CK2 * temp41;
+        const double temp43 = temp42 * temp41;
+        const double rk = r * (1.0 - 1.5 * temp43 * betal * c.x3thm1) + 0.5 * temp42 * c.x1mth2 * cos2u;
+        // uk = u + du, applied by angle addition so no atan2 is needed
+        const double du = -0.25 * temp43 * c.x7thm1 * sin2u;
+        double sin_du, cos_du;
+        sincosKernel(du, sin_du, cos_du);
+        const double sinuk = sinu * cos_du + cosu * sin_du;
+        const double cosuk = cosu * cos_du - sinu * sin_du;
+        const double xnodek = xnode + 1.5 * temp43 * c.cosio * sin2u;
+        const double xinck = c.inclination + 1.5 * temp43 * c.cosio * c.sinio * cos2u;
+        const double rdotk = rdot - xn * temp42 * c.x1mth2 * sin2u;
+        const double rfdotk = rfdot + xn * temp42 * (c.x1mth2 * cos2u + 1.5 * c.x3thm1);
+
+        // 5. Orientation vectors
+        double sinik, cosik, sinnok, cosnok;
+        sincosKernel(xinck, sinik, cosik);
+        sincosKernel(xnodek, sinnok, cosnok);
+        const double xmx = -sinnok * cosik;
+        const double xmy = cosnok * cosik;
+        const double ux = xmx * sinuk + cosnok * cosuk;
+        const double uy = xmy * sinuk + sinnok * cosuk;
+        const double uz = sinik * sinuk;
+        const double wx = xmx * cosuk - cosnok * sinuk;
+        const double wy = xmy * cosuk - sinnok * sinuk;
+        const double wz = sinik * cosuk;
+
+        const bool decayed = !failed && (rk < 1.0);
+        const double keep = (failed || decayed) ? 0.0 : 1.0;
+        const double rs = rk * SGP4_XKMPER * keep;
+        const double vs = SGP4_XKMPER / 60.0 * keep;
+        px = rs * ux; py = rs * uy; pz = rs * uz;
+        vx = (rdotk * ux + rfdotk * wx) * vs;
+        vy = (rdotk * uy + rfdotk * wy) * vs;
+        vz = (rdotk * uz + rfdotk * wz) * vs;
+        return failed ? SGP4_ERROR : (decayed ? SGP4_DECAYED : SGP4_OK);
+    }
+}
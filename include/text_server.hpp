@@ -5,6 +5,7 @@
 #include <thread>
 #include <mutex>
 #include "display.hpp" 
+#include "frame.hpp"
 
 namespace ve {
     class TextServer {
@@ -13,15 +14,15 @@ namespace ve {
         ~TextServer();
         void start();
         void stop();
-        void updateData(const std::string& text_view);
+        // Serves the text view of the latest published frame; the channel must outlive the server
+        void setFrameSource(const FrameChannel* frames) { frames_ = frames; }
 
     private:
         int port_;
         int server_fd_;
         std::atomic<bool> running_;
         std::thread server_thread_;
-        std::mutex data_mutex_;
-        std::string current_text_view_;
+        const FrameChannel* frames_ = nullptr;
 
         void serverLoop();
     };
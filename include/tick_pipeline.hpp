@@ -0,0 +1,77 @@
+#pragma once
+#include "satellite.hpp"
+#include "celestial_body.hpp"
+#include "satellite_batch.hpp"
+#include "frame_context.hpp"
+#include "observer.hpp"
+#include "display.hpp"
+#include "config_manager.hpp"
+#include "scheduler.hpp"
+#include "row_selector.hpp"
+#include <vector>
+
+namespace ve {
+    // The per-tick pass over the catalog, run on the scheduler in shards of
+    // contiguous satellites. Each shard goes through the stages in order:
+    //   1. propagate (batch slice), quarantine failed lanes, slide the ground track
+    //   2. topocentric transform (look angle, range rate)
+    //   3. visibility (batch kernel over the slice), user filters and sort key,
+    //      offered to the shard's top-K
+    // Stages write per-satellite scratch lanes or the shard's own selector,
+    // never shared state. The shard selectors are then merged into the final
+    // max_sats, and
+    //   4. row build (next event, flare, sub-satellite point)
+    // runs only for the selected satellites, writing each row into its slot.
+    // Ties break on catalog index, so the result does not depend on sharding.
+    // Sun and Moon are not in the catalog: their look angles come straight from
+    // the frame's shared positions and, when above min_el, they are always kept.
+    class TickPipeline {
+    public:
+        struct Stats { int rejected_apo = 0; int rejected_el = 0; int rejected_vis = 0; int quarantined = 0; };
+        struct Output {
+            std::vector<DisplayRow> rows;   // Display order, at most max_sats
+            Stats stats;
+            // Look angle of the rotator target, found whatever the display filters say
+            bool has_selected = false;
+            Observer::LookAngle selected_look{};
+        };
+
+        explicit TickPipeline(Scheduler& scheduler) : scheduler_(scheduler) {}
+
+        void run(std::vector<Satellite>& sats, const std::vector<CelestialBody>& bodies, SatelliteBatch& batch,
+                 const Observer& observer, const AppConfig& cfg, const TimePoint& now, int selected_norad_id, Output& out);
+
+    private:
+        struct Shard {
+            TopK top;
+            Stats stats;
+            bool has_selected = false;
+            Observer::LookAngle selected_look{};
+        };
+        // Small enough to balance across workers, large enough to amortize the handoff
+        static constexpr size_t MIN_SHARD = 64;
+
+        void propagateStage(std::vector<Satellite>& sats, SatelliteBatch& batch, const TimePoint& now, size_t begin, size_t end);
+        void topocentricStage(const Observer& observer, const FrameContext& frame, size_t begin, size_t end);
+        void filterStage(const std::vector<Satellite>& sats, const FrameContext& frame, const AppConfig& cfg, SortKey key,
+                         int selected_norad_id, Shard& shard, size_t begin, size_t end);
+        double sortKey(const Satellite& sat, SortKey key, size_t i, const FrameContext& frame);
+        DisplayRow buildRow(const Satellite& sat, const FrameContext& frame, size_t i);
+        DisplayRow buildBodyRow(const CelestialBody& body, const FrameContext& frame, size_t b);
+
+        Scheduler& scheduler_;
+        std::vector<Shard> shards_;         // Reused across ticks to keep their capacity
+
+        // Per-satellite scratch lanes
+        std::vector<double> apogee_;
+        std::vector<uint8_t> live_;         // Propagated and not decayed
+        std::vector<Observer::LookAngle> look_;
+        std::vector<double> range_rate_;
+        std::vector<VisibilityCalculator::State> vis_;
+        std::vector<int8_t> flare_;         // -1 = not computed yet
+        std::vector<Candidate> selected_;
+        // Per-body look and range rate; candidates index them past the catalog
+        std::vector<Observer::LookAngle> body_look_;
+        std::vector<double> body_range_rate_;
+    };
+}
@@ -0,0 +1,47 @@
+#pragma once
+#include "element_store.hpp"
+#include "mapped_file.hpp"
+#include <string>
+#include <memory>
+#include <cstdint>
+
+namespace ve {
+    // Precompiled form of a TLE text file, written beside it as <name>.catalog. It
+    // holds the element lines plus everything Satellite derives from them (mean
+    // elements, epoch, hash, SGP4 near-earth constants) as fixed-size records
+    // followed by a text blob, so a later start maps the file and fills an
+    // ElementStore without parsing or SGP4 init. The header records the size and
+    // mtime of the text file it was compiled from; any change to the text (a
+    // download, a custom group save) makes the catalog stale and it is rebuilt.
+    class TleCatalog {
+    public:
+        TleCatalog() = default;
+        TleCatalog(const TleCatalog&) = delete;
+        TleCatalog& operator=(const TleCatalog&) = delete;
+
+        static std::string pathFor(const std::string& text_path);
+
+        // Maps the catalog for text_path; false if it is missing, stale or corrupt
+        bool open(const std::string& text_path);
+        void close();
+        bool isOpen() const { return file_.isOpen(); }
+
+        size_t size() const { return count_; }
+        // Copies every record into a new store (the mapping can be closed after)
+        std::shared_ptr<ElementStore> load() const;
+
+        // Compiles the element sets parsed from text_path (temp file + rename);
+        // slots that failed to parse are left out
+        static bool save(const std::string& text_path, const ElementStore& store);
+
+    private:
+        struct Header;
+        struct Record;
+
+        MappedFile file_;
+        const Record* records_ = nullptr;
+        size_t count_ = 0;
+        const char* text_ = nullptr;
+        size_t text_size_ = 0;
+    };
+}
@@ -0,0 +1,41 @@
+#pragma once
+#include <string>
+#include <vector>
+#include <ctime>
+#include <curl/curl.h>
+
+namespace ve {
+    // Concurrent element-file downloads over one curl multi handle. The handle
+    // lives as long as the fetcher, so connections (and HTTP/2 sessions) are
+    // reused across groups and across reloads. Each cached file has a sidecar
+    // <file>.meta holding the ETag and Last-Modified of the copy on disk and
+    // when it was last confirmed; the next fetch is a conditional GET, and a
+    // 304 only refreshes the confirmation time, leaving the file untouched.
+    class TleFetcher {
+    public:
+        struct Job {
+            std::string url;
+            std::string path;       // Destination; replaced by rename, never half-written
+        };
+        enum class Result { UPDATED, NOT_MODIFIED, FAILED };
+
+        TleFetcher();
+        ~TleFetcher();
+        TleFetcher(const TleFetcher&) = delete;
+        TleFetcher& operator=(const TleFetcher&) = delete;
+
+        // Runs every job to completion (at most MAX_PER_HOST at a time per
+        // server); results are in job order
+        std::vector<Result> fetch(const std::vector<Job>& jobs);
+
+        // When the file at path was last downloaded or confirmed unchanged (0 if never)
+        static std::time_t lastChecked(const std::string& path);
+
+        static constexpr long MAX_PER_HOST = 4;
+        static constexpr long TIMEOUT_SECS = 45;
+
+    private:
+        struct Transfer;
+        CURLM* multi_ = nullptr;
+    };
+}
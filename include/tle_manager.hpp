@@ -2,40 +2,70 @@
 #include <string>
 #include <vector>
 #include <map>
+#include <memory>
+#include <mutex>
 #include "satellite.hpp"
+#include "tle_parser.hpp"
+#include "catalog_index.hpp"
+#include "cache_watcher.hpp"
+#include "tle_fetcher.hpp"
 
 namespace ve {
+    class Scheduler;
+
     class TLEManager {
     public:
+        static constexpr const char* DEFAULT_SOURCE_URL = "https://celestrak.org/NORAD/elements/gp.php";
+
         TLEManager(const std::string& cache_dir);
+
+        // Element sets are derived in parallel on this pool (serially if unset).
+        // Each group file is compiled to a binary catalog on first parse, so
+        // later loads skip parsing and SGP4 init.
+        void setScheduler(Scheduler* scheduler) { scheduler_ = scheduler; }
+        // Celestrak-style gp.php endpoint groups are fetched from (?GROUP=<name>&FORMAT=tle);
+        // point it at a local mirror for tests or offline sites
+        void setSourceUrl(const std::string& url) { source_url_ = url; }
         
         // Load tracking groups
         std::vector<Satellite> loadGroups(const std::string& groups_list_str);
         
-        // Load specific sats for tracking (from config)
+        // Load specific sats for tracking (from config): every catalog entry whose
+        // name contains one of the comma-separated names (SUN and MOON are
+        // skipped: see CelestialBody::fromSelection)
         std::vector<Satellite> loadSpecificSats(const std::string& sat_names_csv);
         
-        // NEW: Server-Side Search (returns JSON string of matches)
-        std::string searchMasterCatalog(const std::string& query);
+        // Server-side type-ahead search (JSON array of at most limit matches)
+        std::string searchMasterCatalog(const std::string& query, size_t limit = 50);
         
-        // NEW: Save Custom Group
-        void saveCustomGroup(const std::string& group_name, const std::vector<int>& norad_ids);
+        // Writes the given objects to <group_name>.txt in the cache, for --groupsel
+        // (returns the number written; 0 for the name of a downloaded group)
+        size_t saveCustomGroup(const std::string& group_name, const std::vector<int>& norad_ids);
         
-        // NEW: Get Full Catalog for legacy support (optional, but good to have)
+        // Every indexed object (JSON array of id, name, designator, source file)
         std::string getFullCatalogJson();
 
         void clearCache();
 
     private:
         std::string cache_dir_;
-        std::vector<Satellite> master_catalog_; // In-Memory Cache
-        bool master_loaded_ = false;
+        std::string source_url_ = DEFAULT_SOURCE_URL;
+        TleFetcher fetcher_;
+        // Index over every cached element file, built on first use and rebuilt
+        // after a download or once the cache files change on disk
+        std::mutex master_mutex_;
+        std::shared_ptr<const CatalogIndex> master_;
+        CacheWatcher master_watcher_;
+        Scheduler* scheduler_ = nullptr;
 
-        void loadMasterCatalogIfNeeded();
+        std::shared_ptr<const CatalogIndex> masterIndex();
+        void invalidateMaster();
         std::string getUrlForGroup(const std::string& group);
         bool downloadFile(const std::string& url, const std::string& dest_path);
         std::vector<Satellite> parseFile(const std::string& filepath);
-        static size_t WriteCallback(void* contents, size_t size, size_t nmemb, void* userp);
+        // Element sets derived in parallel on the pool, one store per load
+        std::shared_ptr<ElementStore> buildStore(const std::vector<TleRecord>& records);
+        static std::vector<Satellite> satellitesOf(const std::shared_ptr<const ElementStore>& store);
         static std::string trim(const std::string& str);
         bool isCacheFresh(const std::string& filepath);
     };
@@ -0,0 +1,22 @@
+#pragma once
+#include <string_view>
+#include <vector>
+
+namespace ve {
+    // One three-line element set, viewing the text it was scanned from (a
+    // mapped file or a download buffer), which must outlive it.
+    struct TleRecord {
+        std::string_view name;
+        std::string_view line1;
+        std::string_view line2;
+    };
+
+    // Modulo-10 checksum in column 69: digits count their value, '-' counts 1
+    bool tleChecksumOk(std::string_view line);
+
+    // Scans name / line 1 / line 2 records in place, without copying. Lines are
+    // trimmed of blanks and CR; a line 1 without a preceding name is skipped.
+    // Records with a short line, a bad checksum or mismatched catalog numbers
+    // are dropped and counted in rejected.
+    std::vector<TleRecord> scanTle(std::string_view text, size_t* rejected = nullptr);
+}
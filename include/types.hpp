@@ -4,11 +4,9 @@
 #include <chrono>
 #include <ctime>
 #include <deque>
+#include "julian_time.hpp"
 
 namespace ve {
-    using Clock = std::chrono::system_clock;
-    using TimePoint = std::chrono::time_point<Clock>;
-
     struct Vector3 {
         double x, y, z;
         Vector3 operator+(const Vector3& other) const { return {x + other.x, y + other.y, z + other.z}; }
@@ -30,26 +28,37 @@ namespace ve {
     constexpr double RAD2DEG = 180.0 / PI;
 
     inline double toJulianDate(const TimePoint& t) {
-        std::time_t tt = Clock::to_time_t(t);
-        std::tm* gmt = std::gmtime(&tt);
-        int Y = gmt->tm_year + 1900; int M = gmt->tm_mon + 1; int D = gmt->tm_mday;
-        if (M <= 2) { Y -= 1; M += 12; }
-        int A = Y / 100; int B = 2 - A + (A / 4);
-        double jd = std::floor(365.25 * (Y + 4716)) + std::floor(30.6001 * (M + 1)) + D + B - 1524.5;
-        double fraction = (gmt->tm_hour + gmt->tm_min/60.0 + gmt->tm_sec/3600.0) / 24.0;
-        return jd + fraction;
+        return JulianTime::fromTimePoint(t).jd();
     }
 
     // Helper to get GMST for coordinate transforms
     inline double getGMST(const TimePoint& t) {
-        double jd = toJulianDate(t);
-        double jd_midnight = std::floor(jd - 0.5) + 0.5;
-        double T = (jd_midnight - 2451545.0) / 36525.0;
-        double gmst_0h = 24110.54841 + 8640184.812866 * T + 0.093104 * T * T - 6.2e-6 * T * T * T;
-        double ut_hours = (jd - jd_midnight) * 24.0;
-        double gmst_now_sec = gmst_0h + (ut_hours * 3600.0 * 1.00273790935);
-        gmst_now_sec = std::fmod(gmst_now_sec, 86400.0);
-        if (gmst_now_sec < 0) gmst_now_sec += 86400.0;
-        return (gmst_now_sec / 240.0) * DEG2RAD;
+        return JulianTime::fromTimePoint(t).gmst();
+    }
+
+    // ECI (TEME) position to geodetic lat/lon/alt, WGS-72 as in libsgp4's Eci::ToGeodetic.
+    // Replaces a second SGP4 run when the state vector is already known.
+    inline Geodetic eciToGeodetic(const Vector3& eci, double gmst) {
+        constexpr double a = 6378.135;          // WGS-72, matches libsgp4
+        constexpr double f = 1.0 / 298.26;
+        constexpr double e2 = f * (2.0 - f);
+
+        double lon = std::atan2(eci.y, eci.x) - gmst;
+        lon = std::fmod(lon + PI, 2.0 * PI);
+        if (lon < 0) lon += 2.0 * PI;
+        lon -= PI;
+
+        double r = std::sqrt(eci.x * eci.x + eci.y * eci.y);
+        double lat = std::atan2(eci.z, r);
+        double c = 1.0;
+        for (int i = 0; i < 10; ++i) {
+            double phi = lat;
+            double sp = std::sin(phi);
+            c = 1.0 / std::sqrt(1.0 - e2 * sp * sp);
+            lat = std::atan2(eci.z + a * c * e2 * sp, r);
+            if (std::abs(lat - phi) < 1e-10) break;
+        }
+        double alt = r / std::cos(lat) - a * c;
+        return { lat * RAD2DEG, lon * RAD2DEG, alt };
     }
 }
@@ -1,6 +1,10 @@
 #pragma once
 #include "types.hpp"
+#include <cstddef>
+#include <cstdint>
 namespace ve {
+    struct FrameContext;
+
     class VisibilityCalculator {
     public:
         enum class State { VISIBLE, DAYLIGHT, ECLIPSED };
@@ -8,8 +12,21 @@ namespace ve {
         // New Helper to get Lat/Lon of Sun
         static Geodetic getSunPositionGeo(const TimePoint& t);
         static State calculateState(const Vector3& sat, const Vector3& obs, const TimePoint& t, double el);
+        // Per-tick variant: sun vector and observer twilight come from the shared context
+        static State calculateState(const Vector3& sat, const FrameContext& ctx);
 
         // Flare Calculation: Returns 0=None, 1=Near (0.5-1.0), 2=Hit (<0.5)
         static int checkFlare(const Vector3& sat_eci, const Vector3& obs_eci, const Vector3& sun_eci, double apogee_km);
+        static int checkFlare(const Vector3& sat_eci, const FrameContext& ctx, double apogee_km);
+
+        // Batch kernels over count objects in SoA layout (px/py/pz in km, as in
+        // SatelliteBatch). The observer twilight gates are evaluated once per
+        // call; per object only dot products are compared against squared-cosine
+        // thresholds, with no trig, sqrt or early exit, so the loops vectorize.
+        static void calculateStates(const double* px, const double* py, const double* pz, size_t count,
+                                    const Vector3& obs_eci, const Vector3& sun_eci, State* out);
+        // Same codes as checkFlare; objects not VISIBLE in state get 0
+        static void checkFlares(const double* px, const double* py, const double* pz, const double* apogee_km,
+                                const State* state, size_t count, const Vector3& obs_eci, const Vector3& sun_eci, int8_t* out);
     };
 }
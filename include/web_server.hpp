@@ -9,6 +9,7 @@
 #include "config_manager.hpp" 
 #include "visibility.hpp"
 #include "tle_manager.hpp"
+#include "frame.hpp"
 
 namespace ve {
     class WebServer {
@@ -21,7 +22,14 @@ namespace ve {
         void runBlocking(); // Blocking (for Builder Phase)
         void stop();
 
-        void updateData(const std::vector<DisplayRow>& rows, const std::vector<Satellite*>& raw_sats, const AppConfig& config, const TimePoint& t, const std::string& time_str);
+        // Published frames are served as-is; the channel must outlive the server
+        void setFrameSource(const FrameChannel* frames) { frames_ = frames; }
+        // /api/satellites body, built once per tick by the math thread
+        static std::string buildJson(const std::vector<DisplayRow>& rows, const AppConfig& config, const TimePoint& t, const std::string& time_str);
+        // /api/quarantine body: every quarantined object with its reason
+        static std::string buildQuarantineJson(const std::vector<Satellite>& sats);
+        // /api/passes body; times are Unix seconds
+        static std::string buildPassesJson(const EventTimeline& timeline, const std::vector<const EventTimeline::Pass*>& passes, const TimePoint& t);
         
         bool hasPendingConfig();
         AppConfig popPendingConfig();
@@ -36,9 +44,7 @@ namespace ve {
         std::thread server_thread_;
         std::atomic<int> selected_norad_id_{0};
         
-        std::mutex data_mutex_;
-        std::string current_json_data_;
-        AppConfig last_known_config_; 
+        const FrameChannel* frames_ = nullptr;
         
         TLEManager& tle_mgr_;
 
@@ -47,8 +53,10 @@ namespace ve {
         bool config_changed_ = false;
 
         void serverLoop();
-        std::string buildJson(const std::vector<DisplayRow>& rows, const std::vector<Satellite*>& raw_sats, const AppConfig& config, const TimePoint& t, const std::string& time_str);
         void handleRequest(int client_socket, const std::string& request);
+        // Largest request body read (custom group id lists)
+        static constexpr size_t MAX_BODY_BYTES = 1 << 20;
+        static void readBody(int client_socket, std::string& request);
         std::map<std::string, std::string> parseQuery(const std::string& query);
         std::string urlDecode(const std::string& str);
     };
@@ -0,0 +1,43 @@
+#include "cache_watcher.hpp"
+#include <filesystem>
+
+namespace ve {
+    CacheWatcher::CacheWatcher(std::string dir, std::string extension)
+        : dir_(std::move(dir)), extension_(std::move(extension)) {
+        snapshot();
+    }
+
+    CacheWatcher::Listing CacheWatcher::scan() const {
+        Listing out;
+        std::error_code ec;
+        for (const auto& entry : std::filesystem::directory_iterator(dir_, ec)) {
+            if (entry.path().extension() != extension_) continue;
+            std::error_code fec;
+            auto size = entry.file_size(fec);
+            auto mtime = entry.last_write_time(fec);
+            if (fec) continue;      // Removed between listing and stat
+            out[entry.path().filename().string()] = {static_cast<int64_t>(size),
+                                                     static_cast<int64_t>(mtime.time_since_epoch().count())};
+        }
+        return out;
+    }
+
+    void CacheWatcher::snapshot() {
+        baseline_ = scan();
+        has_pending_ = false;
+    }
+
+    bool CacheWatcher::poll() {
+        Listing now = scan();
+        if (now == baseline_) { has_pending_ = false; return false; }
+        // Changed: wait for one more identical read before reporting it
+        if (!has_pending_ || now != pending_) {
+            pending_ = std::move(now);
+            has_pending_ = true;
+            return false;
+        }
+        baseline_ = std::move(pending_);
+        has_pending_ = false;
+        return true;
+    }
+}
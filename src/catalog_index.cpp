@@ -0,0 +1,261 @@
+#include "catalog_index.hpp"
+#include <algorithm>
+#include <cctype>
+#include <array>
+#include <iterator>
+
+namespace ve {
+    namespace {
+        // Normalized text only holds ' ', A-Z and 0-9
+        constexpr int ALPHABET = 37;
+        constexpr uint32_t TRIGRAMS = ALPHABET * ALPHABET * ALPHABET;
+
+        int symbol(char c) {
+            if (c == ' ') return 0;
+            if (c >= 'A' && c <= 'Z') return 1 + (c - 'A');
+            if (c >= '0' && c <= '9') return 27 + (c - '0');
+            return -1;
+        }
+
+        uint32_t trigram(const std::string& s, size_t i) {
+            return (symbol(s[i]) * ALPHABET + symbol(s[i + 1])) * ALPHABET + symbol(s[i + 2]);
+        }
+
+        bool allDigits(std::string_view s) {
+            return !s.empty() && std::all_of(s.begin(), s.end(), [](char c) { return c >= '0' && c <= '9'; });
+        }
+
+        bool allLetters(std::string_view s) {
+            return std::all_of(s.begin(), s.end(), [](char c) { return c >= 'A' && c <= 'Z'; });
+        }
+
+        std::string_view trimView(std::string_view s) {
+            size_t first = s.find_first_not_of(" \t\r\n");
+            if (first == std::string_view::npos) return {};
+            size_t last = s.find_last_not_of(" \t\r\n");
+            return s.substr(first, last - first + 1);
+        }
+
+        // Aho-Corasick over the normalized alphabet, with the failure links
+        // folded into a full transition table
+        class PatternMatcher {
+        public:
+            explicit PatternMatcher(const std::vector<std::string>& patterns) {
+                nodes_.push_back(Node());
+                for (size_t p = 0; p < patterns.size(); ++p) {
+                    if (patterns[p].empty()) continue;
+                    int n = 0;
+                    for (char c : patterns[p]) {
+                        int s = symbol(c);
+                        if (nodes_[n].next[s] < 0) {
+                            nodes_[n].next[s] = static_cast<int>(nodes_.size());
+                            nodes_.push_back(Node());
+                        }
+                        n = nodes_[n].next[s];
+                    }
+                    nodes_[n].patterns.push_back(static_cast<int>(p));
+                }
+                // Breadth first: a node's fail target is always finished before it
+                std::vector<int> queue;
+                for (int& child : nodes_[0].next) {
+                    if (child < 0) child = 0;
+                    else queue.push_back(child);
+                }
+                for (size_t q = 0; q < queue.size(); ++q) {
+                    int n = queue[q];
+                    int fail = nodes_[n].fail;
+                    nodes_[n].out = nodes_[fail].patterns.empty() ? nodes_[fail].out : fail;
+                    for (int s = 0; s < ALPHABET; ++s) {
+                        int child = nodes_[n].next[s];
+                        if (child < 0) {
+                            nodes_[n].next[s] = nodes_[fail].next[s];
+                        } else {
+                            nodes_[child].fail = nodes_[fail].next[s];
+                            queue.push_back(child);
+                        }
+                    }
+                }
+            }
+
+            // Marks every pattern occurring in text; true if any did
+            bool scan(const std::string& text, std::vector<bool>& hit) const {
+                bool any = false;
+                int n = 0;
+                for (char c : text) {
+                    n = nodes_[n].next[symbol(c)];
+                    for (int m = n; m > 0; m = nodes_[m].out) {
+                        for (int p : nodes_[m].patterns) { hit[p] = true; any = true; }
+                    }
+                }
+                return any;
+            }
+
+        private:
+            struct Node {
+                std::array<int, ALPHABET> next;
+                int fail = 0;
+                int out = 0;            // Nearest proper suffix node with patterns (0 = none)
+                std::vector<int> patterns;
+                Node() { next.fill(-1); }
+            };
+            std::vector<Node> nodes_;
+        };
+    }
+
+    std::string CatalogIndex::normalize(std::string_view text) {
+        std::string out;
+        out.reserve(text.size());
+        bool gap = false;
+        for (char c : text) {
+            char u = static_cast<char>(std::toupper(static_cast<unsigned char>(c)));
+            if (symbol(u) > 0) {
+                if (gap && !out.empty()) out += ' ';
+                out += u;
+                gap = false;
+            } else {
+                gap = true;
+            }
+        }
+        return out;
+    }
+
+    std::string CatalogIndex::designatorKey(std::string_view text) {
+        std::string s;
+        for (char c : trimView(text)) s += static_cast<char>(std::toupper(static_cast<unsigned char>(c)));
+        // 1998-067A: full launch year, dash, launch number, piece (a prefix of it is fine)
+        if (s.size() >= 5 && allDigits(std::string_view(s).substr(0, 4)) && s[4] == '-') {
+            std::string_view rest = std::string_view(s).substr(5);
+            size_t digits = rest.find_first_not_of("0123456789");
+            if (digits == std::string_view::npos) digits = rest.size();
+            if (digits > 3 || (digits < 3 && digits < rest.size()) || !allLetters(rest.substr(digits))) return {};
+            return s.substr(2, 2) + std::string(rest);
+        }
+        // 98067A: the TLE form, at least the year and launch number
+        size_t digits = s.find_first_not_of("0123456789");
+        if (digits == std::string::npos) digits = s.size();
+        if (digits != 5 || !allLetters(std::string_view(s).substr(5))) return {};
+        return s;
+    }
+
+    void CatalogIndex::add(const TleRecord& record, std::string_view source) {
+        int id = 0;
+        for (char c : trimView(record.line1.substr(2, 5))) {
+            if (c < '0' || c > '9') return;     // Alpha-5 ids are not indexed
+            id = id * 10 + (c - '0');
+        }
+        if (!by_norad_.emplace(id, static_cast<uint32_t>(entries_.size())).second) return;
+        entries_.push_back({id, std::string(record.name), std::string(trimView(record.line1.substr(9, 8))),
+                            std::string(record.line1), std::string(record.line2), std::string(source)});
+    }
+
+    void CatalogIndex::build() {
+        // 1. Normalized names and the two sorted orders
+        norm_names_.clear();
+        norm_names_.reserve(entries_.size());
+        for (const auto& e : entries_) norm_names_.push_back(normalize(e.name));
+        by_name_.resize(entries_.size());
+        for (uint32_t i = 0; i < by_name_.size(); ++i) by_name_[i] = i;
+        by_designator_ = by_name_;
+        std::sort(by_name_.begin(), by_name_.end(), [&](uint32_t a, uint32_t b) {
+            return norm_names_[a] < norm_names_[b] || (norm_names_[a] == norm_names_[b] && a < b);
+        });
+        std::sort(by_designator_.begin(), by_designator_.end(), [&](uint32_t a, uint32_t b) {
+            return entries_[a].intl_designator < entries_[b].intl_designator;
+        });
+
+        // 2. Trigram postings (each entry once per trigram, in entry order)
+        std::vector<std::vector<uint32_t>> grams(entries_.size());
+        trigram_offsets_.assign(TRIGRAMS + 1, 0);
+        for (uint32_t i = 0; i < entries_.size(); ++i) {
+            const std::string& n = norm_names_[i];
+            for (size_t k = 0; k + 3 <= n.size(); ++k) grams[i].push_back(trigram(n, k));
+            std::sort(grams[i].begin(), grams[i].end());
+            grams[i].erase(std::unique(grams[i].begin(), grams[i].end()), grams[i].end());
+            for (uint32_t g : grams[i]) trigram_offsets_[g + 1]++;
+        }
+        for (uint32_t g = 0; g < TRIGRAMS; ++g) trigram_offsets_[g + 1] += trigram_offsets_[g];
+        trigram_entries_.resize(trigram_offsets_[TRIGRAMS]);
+        std::vector<uint32_t> fill(trigram_offsets_.begin(), trigram_offsets_.end() - 1);
+        for (uint32_t i = 0; i < entries_.size(); ++i) {
+            for (uint32_t g : grams[i]) trigram_entries_[fill[g]++] = i;
+        }
+    }
+
+    const CatalogEntry* CatalogIndex::findNorad(int norad_id) const {
+        auto it = by_norad_.find(norad_id);
+        return it == by_norad_.end() ? nullptr : &entries_[it->second];
+    }
+
+    std::vector<const CatalogEntry*> CatalogIndex::search(std::string_view query, size_t limit) const {
+        std::vector<const CatalogEntry*> out;
+        std::vector<char> seen(entries_.size(), 0);
+        auto push = [&](uint32_t i) {
+            if (out.size() < limit && !seen[i]) { seen[i] = 1; out.push_back(&entries_[i]); }
+        };
+        std::string_view q = trimView(query);
+        if (q.empty() || limit == 0) return out;
+
+        // 1. NORAD id
+        if (allDigits(q) && q.size() <= 9) {
+            auto it = by_norad_.find(std::stoi(std::string(q)));
+            if (it != by_norad_.end()) push(it->second);
+        }
+
+        // 2. Designator prefix
+        std::string key = designatorKey(q);
+        if (!key.empty()) {
+            auto it = std::lower_bound(by_designator_.begin(), by_designator_.end(), key, [&](uint32_t i, const std::string& k) {
+                return entries_[i].intl_designator < k;
+            });
+            for (; it != by_designator_.end() && entries_[*it].intl_designator.compare(0, key.size(), key) == 0; ++it) push(*it);
+        }
+
+        // 3. Name prefix
+        std::string n = normalize(q);
+        if (n.empty()) return out;
+        auto it = std::lower_bound(by_name_.begin(), by_name_.end(), n, [&](uint32_t i, const std::string& k) {
+            return norm_names_[i] < k;
+        });
+        for (; it != by_name_.end() && out.size() < limit && norm_names_[*it].compare(0, n.size(), n) == 0; ++it) push(*it);
+
+        // 4. Substring: intersect the query's trigram lists, shortest first, then verify
+        if (n.size() < 3 || out.size() >= limit) return out;
+        std::vector<uint32_t> grams;
+        for (size_t k = 0; k + 3 <= n.size(); ++k) grams.push_back(trigram(n, k));
+        std::sort(grams.begin(), grams.end(), [&](uint32_t a, uint32_t b) {
+            return trigram_offsets_[a + 1] - trigram_offsets_[a] < trigram_offsets_[b + 1] - trigram_offsets_[b];
+        });
+        std::vector<uint32_t> candidates(trigram_entries_.begin() + trigram_offsets_[grams[0]],
+                                         trigram_entries_.begin() + trigram_offsets_[grams[0] + 1]);
+        for (size_t g = 1; g < grams.size() && !candidates.empty(); ++g) {
+            auto first = trigram_entries_.begin() + trigram_offsets_[grams[g]];
+            auto last = trigram_entries_.begin() + trigram_offsets_[grams[g] + 1];
+            std::vector<uint32_t> kept;
+            std::set_intersection(candidates.begin(), candidates.end(), first, last, std::back_inserter(kept));
+            candidates.swap(kept);
+        }
+        std::vector<uint32_t> hits;
+        for (uint32_t i : candidates) {
+            if (!seen[i] && norm_names_[i].find(n) != std::string::npos) hits.push_back(i);
+        }
+        std::sort(hits.begin(), hits.end(), [&](uint32_t a, uint32_t b) { return norm_names_[a] < norm_names_[b]; });
+        for (uint32_t i : hits) push(i);
+        return out;
+    }
+
+    std::vector<const CatalogEntry*> CatalogIndex::matchAny(const std::vector<std::string>& patterns,
+                                                            std::vector<bool>* pattern_hit) const {
+        std::vector<std::string> norm;
+        norm.reserve(patterns.size());
+        for (const auto& p : patterns) norm.push_back(normalize(p));
+        PatternMatcher matcher(norm);
+
+        std::vector<bool> hit(norm.size(), false);
+        std::vector<const CatalogEntry*> out;
+        for (size_t i = 0; i < entries_.size(); ++i) {
+            if (matcher.scan(norm_names_[i], hit)) out.push_back(&entries_[i]);
+        }
+        if (pattern_hit) *pattern_hit = std::move(hit);
+        return out;
+    }
+}
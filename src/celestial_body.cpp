@@ -0,0 +1,62 @@
+#include "celestial_body.hpp"
+#include "visibility.hpp"
+#include <algorithm>
+#include <cctype>
+#include <cmath>
+#include <sstream>
+
+namespace ve {
+    Vector3 CelestialBody::positionEci(const TimePoint& t) const {
+        if (kind_ == Kind::SUN) return VisibilityCalculator::getSunPositionECI(t);
+        return moonPositionEci(JulianTime::fromTimePoint(t));
+    }
+
+    Vector3 CelestialBody::moonPositionEci(const JulianTime& t) {
+        // Julian centuries from J2000; arguments in degrees
+        const double T = ((t.day - 2451545.0) + t.frac) / 36525.0;
+        auto s = [](double deg) { return std::sin(deg * DEG2RAD); };
+        auto c = [](double deg) { return std::cos(deg * DEG2RAD); };
+
+        // 1. Ecliptic longitude, latitude and horizontal parallax
+        double lambda = 218.32 + 481267.881 * T
+                      + 6.29 * s(135.0 + 477198.87 * T) - 1.27 * s(259.3 - 413335.36 * T)
+                      + 0.66 * s(235.7 + 890534.22 * T) + 0.21 * s(269.9 + 954397.74 * T)
+                      - 0.19 * s(357.5 + 35999.05 * T) - 0.11 * s(186.5 + 966404.03 * T);
+        double beta = 5.13 * s(93.3 + 483202.02 * T) + 0.28 * s(228.2 + 960400.89 * T)
+                    - 0.28 * s(318.3 + 6003.15 * T) - 0.17 * s(217.6 - 407332.21 * T);
+        double parallax = 0.9508 + 0.0518 * c(135.0 + 477198.87 * T) + 0.0095 * c(259.3 - 413335.36 * T)
+                        + 0.0078 * c(235.7 + 890534.22 * T) + 0.0028 * c(269.9 + 954397.74 * T);
+
+        // 2. Distance from the parallax, then rotate the ecliptic direction to the equator
+        double r = EARTH_RADIUS_KM / s(parallax);
+        double eps = 23.439 - 0.0130 * T;
+        double l = c(beta) * c(lambda);
+        double m = c(eps) * c(beta) * s(lambda) - s(eps) * s(beta);
+        double n = s(eps) * c(beta) * s(lambda) + c(eps) * s(beta);
+        return {r * l, r * m, r * n};
+    }
+
+    bool CelestialBody::isBodyName(const std::string& name) {
+        return name == "SUN" || name == "MOON";
+    }
+
+    std::vector<CelestialBody> CelestialBody::fromSelection(const std::string& csv) {
+        std::vector<CelestialBody> bodies;
+        std::stringstream ss(csv);
+        std::string seg;
+        while (std::getline(ss, seg, ',')) {
+            seg.erase(std::remove_if(seg.begin(), seg.end(), [](unsigned char ch) { return std::isspace(ch); }), seg.end());
+            std::transform(seg.begin(), seg.end(), seg.begin(), [](unsigned char ch) { return static_cast<char>(std::toupper(ch)); });
+            if (!isBodyName(seg)) continue;
+            Kind kind = (seg == "SUN") ? Kind::SUN : Kind::MOON;
+            bool seen = std::any_of(bodies.begin(), bodies.end(), [kind](const CelestialBody& b) { return b.kind() == kind; });
+            if (!seen) bodies.emplace_back(kind);
+        }
+        return bodies;
+    }
+
+    void CelestialBody::setPassEvents(std::vector<PassEvent> events, const TimePoint& until) {
+        schedule_.assign(std::move(events));
+        predicted_until_ = until;
+    }
+}
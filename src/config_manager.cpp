@@ -57,6 +57,8 @@ namespace ve {
             if (data.count("min_el")) cfg.min_el = std::stod(data["min_el"]);
             if (data.count("max_apo")) cfg.max_apo = std::stod(data["max_apo"]);
             if (data.count("trail_length_mins")) cfg.trail_length_mins = std::stoi(data["trail_length_mins"]);
+            if (data.count("ephemeris_tolerance_km")) cfg.ephemeris_tolerance_km = std::stod(data["ephemeris_tolerance_km"]);
+            if (data.count("sort_by")) cfg.sort_by = data["sort_by"];
             
             if (data.count("group_selection")) {
                 cfg.group_selection = data["group_selection"];
@@ -64,6 +66,7 @@ namespace ve {
             }
             
             if (data.count("sat_selection")) cfg.sat_selection = data["sat_selection"];
+            if (data.count("tle_source_url") && !data["tle_source_url"].empty()) cfg.tle_source_url = data["tle_source_url"];
 
             // Visibility Setting (New: visible_only)
             if (data.count("visible_only")) cfg.visible_only = (data["visible_only"] == "true" || data["visible_only"] == "1");
@@ -100,8 +103,11 @@ namespace ve {
         file << "min_el: " << config.min_el << "\n";
         file << "max_apo: " << config.max_apo << "\n";
         file << "trail_length_mins: " << config.trail_length_mins << "\n";
+        file << "ephemeris_tolerance_km: " << config.ephemeris_tolerance_km << "\n";
+        file << "sort_by: " << config.sort_by << "\n";
         file << "group_selection: " << config.group_selection << "\n";
         file << "sat_selection: " << config.sat_selection << "\n";
+        file << "tle_source_url: " << config.tle_source_url << "\n";
         file << "visible_only: " << (config.visible_only ? "true" : "false") << "\n";
 
         file << "radio_control: " << (config.radio_control_enabled ? "true" : "false") << "\n";
@@ -1,9 +1,10 @@
 #include "display.hpp"
 #include <algorithm>
 #include <iomanip>
+#include <ctime>
 
 namespace ve {
-    Display::Display() : scroll_offset_(0), input_mode_(InputMode::NORMAL), last_frame_buffer_("Waiting for data..."), last_key_debug_(0) {
+    Display::Display() : scroll_offset_(0), input_mode_(InputMode::NORMAL), last_key_debug_(0) {
         initscr();
         cbreak();
         noecho();
@@ -28,11 +29,6 @@ namespace ve {
         }
     }
 
-    std::string Display::getLastFrame() const {
-        std::lock_guard<std::mutex> lock(frame_mutex_);
-        return last_frame_buffer_;
-    }
-    
     void Display::setBlocking(bool blocking) {
         timeout(blocking ? 100 : 0);
     }
@@ -56,46 +52,47 @@ namespace ve {
         else if (ch == KEY_DOWN) scroll_offset_++;
         else if (ch == KEY_PPAGE) { scroll_offset_ -= 10; if (scroll_offset_ < 0) scroll_offset_ = 0; }
         else if (ch == KEY_NPAGE) scroll_offset_ += 10;
+        else if (ch == 'p' || ch == 'P') {
+            view_ = (view_ == View::TRACKER) ? View::PASSES : View::TRACKER;
+            scroll_offset_ = 0;
+        }
         
         return InputResult::NONE;
     }
     
-    void Display::update(const std::vector<DisplayRow>& rows, const Observer& obs, const TimePoint& t, int total_tracked, int filter_kept, bool show_all_rf, double min_el, const std::string& time_str) {
-        std::stringstream ss; 
-        
-        drawHeader(obs, rows.size(), total_tracked, filter_kept, time_str);
-        
-        std::time_t tt = Clock::to_time_t(t);
+    std::string formatNextEvent(const DisplayRow& r, const TimePoint& now) {
+        if (r.pending) return "pending";
+        if (!r.has_next_event) return "--";
+        long diff = std::chrono::duration_cast<std::chrono::seconds>(r.next_event_time - now).count();
+        if (diff < 0) diff = 0;     // Frame slightly older than the renderer's clock
+        long mm = diff / 60;
+        char buf[32];
+        if (mm >= 60) snprintf(buf, sizeof(buf), "%s %ldh %ldm", r.next_is_aos ? "AOS" : "LOS", mm / 60, mm % 60);
+        else snprintf(buf, sizeof(buf), "%s %ldm %lds", r.next_is_aos ? "AOS" : "LOS", mm, diff % 60);
+        return buf;
+    }
+
+    std::string Display::renderText(const std::vector<DisplayRow>& rows, const Geodetic& loc, const TimePoint& t, const std::string& time_str) {
+        std::stringstream ss;
         ss << "VISIBLE EPHEMERIS v12.65-CODE-ONLY\n";
         ss << time_str << "\n";
-        auto loc = obs.getLocation();
         ss << "OBS: " << loc.lat_deg << ", " << loc.lon_deg << " | SHOWN: " << rows.size() << "\n\n";
 
-        int start_y = 5;
-        int available_lines = LINES - start_y - 1; 
-        int max_offset = (int)rows.size() - available_lines;
-        if (max_offset < 0) max_offset = 0;
-        if (scroll_offset_ > max_offset) scroll_offset_ = max_offset;
-
         const char* hdr_fmt = "%-15s %8s %8s %10s %8s %-5s %-12s";
-        if(input_mode_ != InputMode::CONFIRM_QUIT) {
-            mvprintw(3, 0, hdr_fmt, "NAME", "AZ", "EL", "RANGE", "RR(km/s)", "VIS", "NEXT EVENT");
-            clrtoeol(); 
-            mvprintw(4, 0, "-------------------------------------------------------------------------");
-            clrtoeol(); 
-        }
-        
         char buf[256];
         snprintf(buf, sizeof(buf), hdr_fmt, "NAME", "AZ", "EL", "RANGE", "RR(km/s)", "VIS", "NEXT EVENT");
         ss << buf << "\n-------------------------------------------------------------------------\n";
 
         // --- TEXT BUFFER GENERATION (SORTED BY NAME) ---
-        std::vector<DisplayRow> text_rows = rows;
-        std::sort(text_rows.begin(), text_rows.end(), [](const DisplayRow& a, const DisplayRow& b) {
-            return a.name < b.name;
+        std::vector<const DisplayRow*> text_rows;
+        text_rows.reserve(rows.size());
+        for (const auto& r : rows) text_rows.push_back(&r);
+        std::sort(text_rows.begin(), text_rows.end(), [](const DisplayRow* a, const DisplayRow* b) {
+            return a->name < b->name;
         });
 
-        for (const auto& r : text_rows) {
+        for (const DisplayRow* rp : text_rows) {
+            const auto& r = *rp;
             std::string state_str = "---";
             if (r.state == VisibilityCalculator::State::VISIBLE) state_str = "VIS";
             else if (r.state == VisibilityCalculator::State::DAYLIGHT) state_str = "DAY";
@@ -108,13 +105,37 @@ namespace ve {
             const char* row_fmt = "%-15s %8.1f %8.1f %10.1f %8.3f %-5s %-12s";
             snprintf(buf, sizeof(buf), row_fmt, 
                      d_name.c_str(), r.az, r.el, r.range, r.range_rate,
-                     state_str.c_str(), r.next_event.c_str());
+                     state_str.c_str(), formatNextEvent(r, t).c_str());
             ss << buf << "\n";
         }
+        return ss.str();
+    }
+
+    void Display::update(const std::vector<DisplayRow>& rows, const Geodetic& obs, const TimePoint& t, int total_tracked, int quarantined, int filter_kept, bool show_all_rf, double min_el, const std::string& time_str,
+                         const EventTimeline* timeline) {
+        drawHeader(obs, rows.size(), total_tracked, quarantined, filter_kept, time_str);
+
+        if (view_ == View::PASSES && input_mode_ != InputMode::CONFIRM_QUIT) {
+            drawPasses(timeline, t, min_el);
+            drawFooter();
+            refresh();
+            return;
+        }
+        
+        std::time_t tt = Clock::to_time_t(t);
+
+        int start_y = 5;
+        int available_lines = LINES - start_y - 1; 
+        int max_offset = (int)rows.size() - available_lines;
+        if (max_offset < 0) max_offset = 0;
+        if (scroll_offset_ > max_offset) scroll_offset_ = max_offset;
 
-        {
-            std::lock_guard<std::mutex> lock(frame_mutex_);
-            last_frame_buffer_ = ss.str();
+        const char* hdr_fmt = "%-15s %8s %8s %10s %8s %-5s %-12s";
+        if(input_mode_ != InputMode::CONFIRM_QUIT) {
+            mvprintw(3, 0, hdr_fmt, "NAME", "AZ", "EL", "RANGE", "RR(km/s)", "VIS", "NEXT EVENT");
+            clrtoeol(); 
+            mvprintw(4, 0, "-------------------------------------------------------------------------");
+            clrtoeol(); 
         }
 
         if (input_mode_ == InputMode::CONFIRM_QUIT) {
@@ -177,7 +198,7 @@ namespace ve {
                 attron(COLOR_PAIR(color));
                 mvprintw(start_y + i, 0, row_fmt, 
                          d_name.c_str(), r.az, r.el, r.range, r.range_rate,
-                         state_str.c_str(), r.next_event.c_str());
+                         state_str.c_str(), formatNextEvent(r, t).c_str());
                 attroff(COLOR_PAIR(color));
                 clrtoeol(); 
             }
@@ -190,6 +211,72 @@ namespace ve {
         refresh();
     }
 
+    void Display::drawPasses(const EventTimeline* timeline, const TimePoint& t, double min_el) {
+        int start_y = 5;
+        int available_lines = LINES - start_y - 1;
+
+        const char* hdr_fmt = "%-15s %-8s %-8s %6s %7s %7s %7s";
+        mvprintw(3, 0, hdr_fmt, "NAME", "AOS", "IN", "DUR", "MAX EL", "AOS AZ", "LOS AZ");
+        clrtoeol();
+        mvprintw(4, 0, "-------------------------------------------------------------------------");
+        clrtoeol();
+
+        if (!timeline) {
+            mvprintw(start_y, 0, "PASS PREDICTIONS NOT READY.");
+            clrtoeol(); clrtobot();
+            return;
+        }
+
+        // Only as many passes as the scroll position and screen need
+        auto passes = timeline->nextPasses(t, scroll_offset_ + available_lines, std::max(min_el, 0.0));
+        int max_offset = (int)passes.size() - available_lines;
+        if (max_offset < 0) max_offset = 0;
+        if (scroll_offset_ > max_offset) scroll_offset_ = max_offset;
+        if (passes.empty()) {
+            mvprintw(start_y, 0, "NO PASSES PREDICTED ABOVE %.1f DEG.", std::max(min_el, 0.0));
+            clrtoeol();
+        }
+
+        for (int i = 0; i < available_lines; ++i) {
+            int data_idx = scroll_offset_ + i;
+            if (data_idx >= (int)passes.size()) {
+                move(start_y + i, 0); clrtoeol(); continue;
+            }
+            const auto& p = *passes[data_idx];
+
+            // Local wall clock; in --time mode the physics epoch was built with mktime, so this matches the header
+            char aos_buf[16] = "--";
+            if (p.has_aos) {
+                std::time_t aos_tt = Clock::to_time_t(p.aos);
+                std::tm aos_tm;
+                localtime_r(&aos_tt, &aos_tm);
+                std::strftime(aos_buf, sizeof(aos_buf), "%H:%M:%S", &aos_tm);
+            }
+
+            char in_buf[16] = "UP";
+            bool up = p.aos <= t;
+            if (!up) {
+                long diff = std::chrono::duration_cast<std::chrono::seconds>(p.aos - t).count();
+                long mm = diff / 60;
+                if (mm >= 60) snprintf(in_buf, sizeof(in_buf), "%ldh %ldm", mm / 60, mm % 60);
+                else snprintf(in_buf, sizeof(in_buf), "%ldm %lds", mm, diff % 60);
+            }
+
+            long dur = std::chrono::duration_cast<std::chrono::seconds>(p.los - p.aos).count();
+            char dur_buf[16];
+            snprintf(dur_buf, sizeof(dur_buf), "%s%ld:%02ld", p.has_los ? "" : ">", dur / 60, dur % 60);
+
+            int color = up ? 1 : 3;
+            attron(COLOR_PAIR(color));
+            mvprintw(start_y + i, 0, "%-15s %-8s %-8s %6s %7.1f %7.1f %7.1f",
+                     timeline->name(p).substr(0, 14).c_str(),
+                     aos_buf, in_buf, dur_buf, p.max_el, p.aos_az, p.los_az);
+            attroff(COLOR_PAIR(color));
+            clrtoeol();
+        }
+        clrtobot();
+    }
+
     void Display::drawScrollbar(int total_rows, int visible_rows) {
         if (total_rows <= visible_rows) return;
         int start_y = 5;
@@ -205,7 +292,7 @@ namespace ve {
         attroff(COLOR_PAIR(6));
     }
 
-    void Display::drawHeader(const Observer& obs, int visible, int total, int kept, const std::string& time_str) {
+    void Display::drawHeader(const Geodetic& loc, int visible, int total, int quarantined, int kept, const std::string& time_str) {
         attron(COLOR_PAIR(5));
         move(0,0);
         printw("VISIBLE EPHEMERIS v12.65-CODE-ONLY - CONF: config.yaml");
@@ -213,15 +300,15 @@ namespace ve {
         mvprintw(0, COLS-30, "%s", time_str.c_str());
         attroff(COLOR_PAIR(5));
         
-        auto loc = obs.getLocation();
         mvprintw(1, 1, "OBSERVER: %.4f, %.4f  |  TRACKED: %d  |  SHOWN: %d", 
                  loc.lat_deg, loc.lon_deg, total, visible);
+        if (quarantined > 0) printw("  |  QUARANTINED: %d", quarantined);
         clrtoeol();
     }
     void Display::drawFooter() {
         attron(COLOR_PAIR(5));
         move(LINES-1, 0);
-        printw("Controls: [UP/DOWN] Scroll  [q] Quit  [LastKey: %d]", last_key_debug_);
+        printw("Controls: [UP/DOWN] Scroll  [p] %s  [q] Quit  [LastKey: %d]", view_ == View::PASSES ? "Tracker" : "Passes", last_key_debug_);
         clrtoeol();
         attroff(COLOR_PAIR(5));
     }
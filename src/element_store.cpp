@@ -0,0 +1,51 @@
+#include "element_store.hpp"
+#include <cstring>
+
+namespace ve {
+    static_assert(sizeof(ElementRecord) % 64 == 0, "records must tile whole cache lines");
+
+    void ElementRecord::deriveOrbit() {
+        apogee_km = perigee_km = period_min = 0.0;
+        if (elements.mean_motion <= 0.0) return;
+        double n = elements.mean_motion / 60.0;     // rad/s
+        double mu = 398600.4418;
+        double a = std::cbrt(mu / (n * n));
+        apogee_km = a * (1.0 + elements.eccentricity) - EARTH_RADIUS_KM;
+        perigee_km = a * (1.0 - elements.eccentricity) - EARTH_RADIUS_KM;
+        period_min = SGP4_TWOPI / elements.mean_motion;
+    }
+
+    ElementStore::ElementStore(size_t capacity) : records_(capacity), text_(capacity) {}
+
+    const char* ElementStore::copy(std::string_view s) {
+        if (s.empty()) return "";
+        if (block_used_ + s.size() > BLOCK_SIZE) {
+            blocks_.push_back(std::make_unique<char[]>(BLOCK_SIZE));
+            block_used_ = 0;
+        }
+        char* dst = blocks_.back().get() + block_used_;
+        std::memcpy(dst, s.data(), s.size());
+        block_used_ += s.size();
+        return dst;
+    }
+
+    void ElementStore::setText(size_t i, std::string_view name, std::string_view line1, std::string_view line2) {
+        // Lengths are 16-bit, which always fits a block
+        auto clip = [](std::string_view s) { return s.substr(0, UINT16_MAX); };
+        name = clip(name); line1 = clip(line1); line2 = clip(line2);
+        TextRef& t = text_[i];
+        auto it = names_.find(name);
+        if (it == names_.end()) it = names_.insert(std::string_view(copy(name), name.size())).first;
+        t.name = it->data();
+        t.name_len = static_cast<uint16_t>(name.size());
+        t.line1 = copy(line1);
+        t.line1_len = static_cast<uint16_t>(line1.size());
+        t.line2 = copy(line2);
+        t.line2_len = static_cast<uint16_t>(line2.size());
+    }
+
+    size_t ElementStore::memoryBytes() const {
+        return records_.capacity() * sizeof(ElementRecord) + text_.capacity() * sizeof(TextRef) +
+               blocks_.size() * BLOCK_SIZE + names_.size() * (sizeof(std::string_view) + sizeof(void*));
+    }
+}
@@ -0,0 +1,114 @@
+#include "ephemeris.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace ve {
+    bool ChebyshevEphemeris::build(const Sampler& sample, double t_begin, double t_end, double period_mins, double tolerance_km) {
+        segments_.clear();
+        max_error_km_ = 0.0;
+        t_begin_ = t_end_ = t_begin;
+        if (t_end <= t_begin || tolerance_km <= 0.0) return false;
+
+        // Half an orbit is smooth enough for DEGREE 11 on near-circular orbits;
+        // eccentric ones get split further around perigee by fitSegment.
+        double span = std::clamp(period_mins * 0.5, MIN_SPAN_MINS, 720.0);
+        for (double t0 = t_begin; t0 < t_end; t0 += span) {
+            double t1 = std::min(t0 + span, t_end);
+            if (!fitSegment(sample, t0, t1, tolerance_km, 0)) break;
+        }
+        if (segments_.empty()) return false;
+        t_end_ = segments_.back().t1;
+        return true;
+    }
+
+    bool ChebyshevEphemeris::assign(std::vector<Segment> segments, double max_error_km) {
+        for (size_t i = 1; i < segments.size(); ++i) {
+            if (std::abs(segments[i].t0 - segments[i - 1].t1) > 1e-9) return false;
+        }
+        segments_ = std::move(segments);
+        max_error_km_ = max_error_km;
+        t_begin_ = segments_.empty() ? 0.0 : segments_.front().t0;
+        t_end_ = segments_.empty() ? 0.0 : segments_.back().t1;
+        return !segments_.empty();
+    }
+
+    bool ChebyshevEphemeris::fitSegment(const Sampler& sample, double t0, double t1, double tolerance_km, int depth) {
+        const double mid = 0.5 * (t0 + t1);
+        const double half = 0.5 * (t1 - t0);
+
+        // 1. Sample at the Chebyshev nodes and project onto T_0..T_DEGREE
+        Segment seg;
+        seg.t0 = t0; seg.t1 = t1;
+        double f[3][COEFFS];
+        for (int k = 0; k < COEFFS; ++k) {
+            double x = std::cos(PI * (k + 0.5) / COEFFS);
+            Vector3 pos, vel;
+            if (!sample(mid + half * x, pos, vel)) return false;
+            f[0][k] = pos.x; f[1][k] = pos.y; f[2][k] = pos.z;
+        }
+        for (int axis = 0; axis < 3; ++axis) {
+            for (int j = 0; j < COEFFS; ++j) {
+                double sum = 0.0;
+                for (int k = 0; k < COEFFS; ++k) sum += f[axis][k] * std::cos(PI * j * (k + 0.5) / COEFFS);
+                double c = sum * 2.0 / COEFFS;
+                seg.c[axis][j] = static_cast<float>(j == 0 ? 0.5 * c : c);
+            }
+        }
+
+        // 2. Check against the sampler between the nodes (and at both ends)
+        double err_pos = 0.0;
+        for (int k = 0; k <= COEFFS; ++k) {
+            double t = mid + half * std::cos(PI * k / COEFFS);
+            Vector3 ref_pos, ref_vel, pos, vel;
+            if (!sample(t, ref_pos, ref_vel)) return false;
+            evalSegment(seg, t, pos, vel);
+            err_pos = std::max(err_pos, (pos - ref_pos).magnitude());
+        }
+
+        // Only position is bounded: velocity is the derivative of the fit and
+        // stays within a few m/s, which is plenty for range rate / Doppler.
+        if (err_pos > tolerance_km && half >= MIN_SPAN_MINS && depth < 16) {
+            return fitSegment(sample, t0, mid, tolerance_km, depth + 1) &&
+                   fitSegment(sample, mid, t1, tolerance_km, depth + 1);
+        }
+
+        max_error_km_ = std::max(max_error_km_, err_pos);
+        segments_.push_back(seg);
+        return true;
+    }
+
+    void ChebyshevEphemeris::evalSegment(const Segment& s, double tsince, Vector3& pos, Vector3& vel) {
+        const double scale = 2.0 / (s.t1 - s.t0);
+        const double x = (tsince - s.t0) * scale - 1.0;
+        double p[3], d[3];
+        for (int axis = 0; axis < 3; ++axis) {
+            const float* c = s.c[axis];
+            // T_k and dT_k/dx by the three-term recurrence
+            double t_prev = 1.0, t_cur = x;
+            double d_prev = 0.0, d_cur = 1.0;
+            double sp = c[0] + c[1] * x;
+            double sd = c[1];
+            for (int k = 2; k < COEFFS; ++k) {
+                double t_next = 2.0 * x * t_cur - t_prev;
+                double d_next = 2.0 * t_cur + 2.0 * x * d_cur - d_prev;
+                sp += c[k] * t_next;
+                sd += c[k] * d_next;
+                t_prev = t_cur; t_cur = t_next;
+                d_prev = d_cur; d_cur = d_next;
+            }
+            p[axis] = sp;
+            d[axis] = sd * scale / 60.0;    // km/min -> km/s
+        }
+        pos = {p[0], p[1], p[2]};
+        vel = {d[0], d[1], d[2]};
+    }
+
+    bool ChebyshevEphemeris::evaluate(double tsince, Vector3& pos, Vector3& vel) const {
+        if (!covers(tsince)) return false;
+        auto it = std::upper_bound(segments_.begin(), segments_.end(), tsince,
+                                   [](double t, const Segment& s) { return t < s.t1; });
+        if (it == segments_.end()) return false;
+        evalSegment(*it, tsince, pos, vel);
+        return true;
+    }
+}
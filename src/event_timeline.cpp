@@ -0,0 +1,67 @@
+#include "event_timeline.hpp"
+#include <algorithm>
+
+namespace ve {
+    EventTimeline::EventTimeline(std::vector<Pass> passes, std::vector<std::string> names)
+        : passes_(std::move(passes)), names_(std::move(names)) {
+        std::sort(passes_.begin(), passes_.end(), [](const Pass& a, const Pass& b) {
+            return (a.aos != b.aos) ? a.aos < b.aos : a.norad_id < b.norad_id;
+        });
+        max_los_.resize(passes_.size());
+        buildMaxLos(0, passes_.size());
+    }
+
+    TimePoint EventTimeline::buildMaxLos(size_t lo, size_t hi) {
+        if (lo >= hi) return TimePoint::min();
+        size_t mid = lo + (hi - lo) / 2;
+        TimePoint m = std::max({passes_[mid].los, buildMaxLos(lo, mid), buildMaxLos(mid + 1, hi)});
+        max_los_[mid] = m;
+        return m;
+    }
+
+    void EventTimeline::collect(size_t lo, size_t hi, const TimePoint& from, const TimePoint& to, double min_el,
+                                std::vector<const Pass*>& out) const {
+        if (lo >= hi) return;
+        size_t mid = lo + (hi - lo) / 2;
+        // Everything below this node has set before the window opens
+        if (max_los_[mid] < from) return;
+        collect(lo, mid, from, to, min_el, out);
+        // Sorted by AOS: this node and its right subtree rise after the window closes
+        if (passes_[mid].aos > to) return;
+        const Pass& p = passes_[mid];
+        if (p.los >= from && p.max_el >= min_el) out.push_back(&p);
+        collect(mid + 1, hi, from, to, min_el, out);
+    }
+
+    std::vector<const EventTimeline::Pass*> EventTimeline::query(const TimePoint& from, const TimePoint& to, double min_el) const {
+        std::vector<const Pass*> out;
+        collect(0, passes_.size(), from, to, min_el, out);
+        return out;
+    }
+
+    std::vector<const EventTimeline::Pass*> EventTimeline::nextPasses(const TimePoint& t, size_t count, double min_el) const {
+        // 1. Passes up at t (AOS <= t <= LOS)
+        std::vector<const Pass*> out = query(t, t, min_el);
+        if (out.size() > count) out.resize(count);
+        // 2. Then the rises after t, straight off the sorted array
+        auto it = std::upper_bound(passes_.begin(), passes_.end(), t, [](const TimePoint& v, const Pass& p) { return v < p.aos; });
+        for (; it != passes_.end() && out.size() < count; ++it) {
+            if (it->max_el >= min_el) out.push_back(&*it);
+        }
+        return out;
+    }
+
+    std::vector<EventTimeline::Event> EventTimeline::events(const TimePoint& from, const TimePoint& to, double min_el) const {
+        std::vector<Event> out;
+        auto add = [&](const TimePoint& time, EventType type, const Pass* p) {
+            if (time >= from && time <= to) out.push_back({time, type, p});
+        };
+        for (const Pass* p : query(from, to, min_el)) {
+            if (p->has_aos) add(p->aos, EventType::AOS, p);
+            add(p->tca, EventType::TCA, p);
+            if (p->has_los) add(p->los, EventType::LOS, p);
+        }
+        std::stable_sort(out.begin(), out.end(), [](const Event& a, const Event& b) { return a.time < b.time; });
+        return out;
+    }
+}
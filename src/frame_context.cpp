@@ -0,0 +1,31 @@
+#include "frame_context.hpp"
+#include "visibility.hpp"
+#include "celestial_body.hpp"
+#include <cmath>
+
+namespace ve {
+    FrameContext::FrameContext(const TimePoint& t, const Observer& observer, const SatelliteBatch* batch)
+        : time(t), jtime(JulianTime::fromTimePoint(t)), jd(jtime.jd()), gmst(jtime.gmst()), states(batch) {
+        // 1. Observer
+        obs_pos = observer.getPositionECI(gmst);
+        constexpr double omega = 7.2921159e-5;
+        obs_vel = { -omega * obs_pos.y, omega * obs_pos.x, 0.0 };
+        obs_dir = obs_pos.normalize();
+
+        // 2. Topocentric rotation at local sidereal time
+        Geodetic loc = observer.getLocation();
+        double lat = loc.lat_deg * DEG2RAD;
+        double lst = gmst + loc.lon_deg * DEG2RAD;
+        double sL = std::sin(lat); double cL = std::cos(lat);
+        double sLS = std::sin(lst); double cLS = std::cos(lst);
+        south = { sL * cLS, sL * sLS, -cL };
+        east = { -sLS, cLS, 0.0 };
+        zenith = { cL * cLS, cL * sLS, sL };
+
+        // 3. Sun
+        sun = VisibilityCalculator::getSunPositionECI(t);
+        sun_dir = sun.normalize();
+        sun_el = (PI / 2.0) - std::acos(obs_dir.dot(sun_dir));
+        moon = CelestialBody::moonPositionEci(jtime);
+    }
+}
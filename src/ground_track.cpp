@@ -0,0 +1,81 @@
+#include "ground_track.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace ve {
+    void GroundTrack::reset(const TimePoint& now, int half_width_mins, int max_step_secs, const Sampler& sample) {
+        half_width_ = std::chrono::minutes(std::max(half_width_mins, 0));
+        max_step_secs_ = std::max(max_step_secs, MIN_STEP_SECS);
+        // Densest possible sampling over the full window, plus slack for the head sample
+        size_t capacity = static_cast<size_t>(2 * half_width_.count() / MIN_STEP_SECS) + 4;
+        buf_.assign(capacity, Point{});
+        head_ = 0;
+        count_ = 0;
+        now_ = now;
+        next_t_ = now - half_width_;
+        fillTo(now + half_width_, sample);
+    }
+
+    void GroundTrack::advance(const TimePoint& now, const Sampler& sample) {
+        if (buf_.empty()) return;
+        if (now < now_ || now - now_ > half_width_) {
+            reset(now, static_cast<int>(half_width_.count() / 60), max_step_secs_, sample);
+            return;
+        }
+        now_ = now;
+        // 1. Expire the tail
+        TimePoint oldest = now - half_width_;
+        while (count_ > 0 && at(0).t < oldest) popFront();
+        // 2. Extend the head
+        fillTo(now + half_width_, sample);
+    }
+
+    std::vector<Geodetic> GroundTrack::copy() const {
+        std::vector<Geodetic> out;
+        out.reserve(count_);
+        for (size_t i = 0; i < count_; ++i) out.push_back(at(i).geo);
+        return out;
+    }
+
+    void GroundTrack::push(const Point& p) {
+        if (count_ == buf_.size()) popFront();
+        buf_[(head_ + count_) % buf_.size()] = p;
+        count_++;
+    }
+
+    void GroundTrack::popFront() {
+        head_ = (head_ + 1) % buf_.size();
+        count_--;
+    }
+
+    int GroundTrack::stepSecs(const Point& a, const Point& b) const {
+        double dt = std::chrono::duration<double>(b.t - a.t).count();
+        if (dt <= 0.0) return max_step_secs_;
+        double dlat = b.geo.lat_deg - a.geo.lat_deg;
+        double dlon = std::fmod(std::abs(b.geo.lon_deg - a.geo.lon_deg), 360.0);
+        if (dlon > 180.0) dlon = 360.0 - dlon;
+        double rate = std::sqrt(dlat * dlat + dlon * dlon) / dt;    // Map degrees per second
+        if (rate <= 0.0) return max_step_secs_;
+        double step = TARGET_STEP_DEG / rate;
+        return static_cast<int>(std::clamp(step, static_cast<double>(MIN_STEP_SECS), static_cast<double>(max_step_secs_)));
+    }
+
+    int GroundTrack::nextStepSecs(const Sampler& sample) const {
+        if (count_ == 0) return max_step_secs_;
+        const Point& b = at(count_ - 1);
+        if (count_ >= 2) return stepSecs(at(count_ - 2), b);
+        // A lone sample has no rate yet: probe one minimum step ahead, so a window
+        // samples the same way whether it was reset or slid into place
+        Point probe{b.t + std::chrono::seconds(MIN_STEP_SECS), {}};
+        if (!sample(probe.t, probe.geo)) return max_step_secs_;
+        return stepSecs(b, probe);
+    }
+
+    void GroundTrack::fillTo(const TimePoint& end, const Sampler& sample) {
+        while (next_t_ <= end) {
+            Geodetic g;
+            if (sample(next_t_, g)) push({next_t_, g});
+            next_t_ += std::chrono::seconds(nextStepSecs(sample));
+        }
+    }
+}
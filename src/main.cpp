@@ -4,16 +4,28 @@
 #include <algorithm>
 #include <atomic>
 #include <csignal>
+#include <future>
 #include "satellite.hpp"
+#include "satellite_batch.hpp"
+#include "ephemeris.hpp"
 #include "observer.hpp"
 #include "visibility.hpp"
 #include "tle_manager.hpp"
+#include "catalog_diff.hpp"
+#include "cache_watcher.hpp"
 #include "display.hpp"
 #include "web_server.hpp"
 #include "text_server.hpp"
 #include "config_manager.hpp"
 #include "pass_predictor.hpp"
-#include "thread_pool.hpp"
+#include "pass_horizon.hpp"
+#include "celestial_body.hpp"
+#include "pass_cache.hpp"
+#include "precalc.hpp"
+#include "tick_pipeline.hpp"
+#include "frame.hpp"
+#include "row_selector.hpp"
+#include "scheduler.hpp"
 #include "logger.hpp"
 #include "rotator.hpp"
 
@@ -30,17 +42,21 @@ void print_help() {
               << "  --refresh        Force fresh TLE\n"
               << "  --groupsel <list> Comma-separated groups (e.g. \"amateur,weather,stations\")\n"
               << "  --satsel <list>   Comma-separated Satellite Names (Overrules groupsel)\n"
+              << "  --tle_url <url>  TLE source endpoint (default Celestrak gp.php)\n"
               << "  --visible <bool> Limit to Optically Visible only (true/false)\n"
+              << "  --sortby <key>   Display order: el, range, aos, flare (default el)\n"
               << "  --time <str>     Simulate time (e.g. \"2025-01-01 12:00:00\")\n"
               << "\nConfiguration is loaded from config.yaml by default.\n";
 }
 
-struct SharedState {
-    std::mutex mutex;
-    std::vector<DisplayRow> rows;
-    std::vector<Satellite*> active_sats;
-    bool updated = false;
-};
+// Wall-clock string for the display epoch ("face value" local time)
+std::string formatDisplayTime(std::time_t display_tt) {
+    std::tm tm_display;
+    gmtime_r(&display_tt, &tm_display);
+    char t_buf[64];
+    std::strftime(t_buf, sizeof(t_buf), "%Y-%m-%d %H:%M:%S LOC", &tm_display);
+    return std::string(t_buf);
+}
 
 // Helper to check string containment case-insensitive
 bool hasString(const std::string& haystack, const std::string& needle) {
@@ -89,35 +105,8 @@ std::time_t timegm_portable(struct tm* tm) {
     return total_seconds;
 }
 
-// Helper function for batch pre-calculation
-void run_precalc(std::vector<Satellite>& satellites, const Observer& obs, ThreadPool& pool, const AppConfig& cfg, std::chrono::system_clock::time_point start_time) {
-    if (satellites.empty()) return;
-
-    std::atomic<int> tasks_remaining(satellites.size());
-    std::cout << "Pre-calculating passes for " << satellites.size() << " satellites (24h horizon)..." << std::endl;
-
-    for(auto& sat : satellites) {
-        pool.enqueue([&sat, obs, start_time, cfg, &tasks_remaining]() {
-            PassPredictor local_predictor(obs);
-            auto passes = local_predictor.predict(sat, start_time); // Default 1440 mins (24h)
-            sat.setPredictedPasses(passes);
-            // Also calculate initial ground track (valid for start_time)
-            sat.calculateGroundTrack(start_time, cfg.trail_length_mins, 60);
-            tasks_remaining--;
-        });
-    }
-
-    // Blocking wait with progress
-    int total = satellites.size();
-    while(tasks_remaining > 0) {
-        int done = total - tasks_remaining;
-        if (done % 50 == 0 || done == total) {
-            std::cout << "\rProgress: " << done << "/" << total << "   " << std::flush;
-        }
-        std::this_thread::sleep_for(std::chrono::milliseconds(50));
-    }
-    std::cout << "\nPre-calculation complete." << std::endl;
-}
+// Precalc results persist here between runs (cleared with the TLE cache)
+const char* PASS_CACHE_PATH = "./tle_cache/passes.bin";
 
 int main(int argc, char* argv[]) {
     signal(SIGPIPE, SIG_IGN);
@@ -204,6 +193,8 @@ int main(int argc, char* argv[]) {
         else if (arg == "--minel") { if (i+1 < argc) config.min_el = std::stod(argv[++i]); }
         else if (arg == "--groupsel") { if (i+1 < argc) config.group_selection = argv[++i]; config.sat_selection = ""; } 
         else if (arg == "--satsel") { if (i+1 < argc) config.sat_selection = argv[++i]; } 
+        else if (arg == "--tle_url") { if (i+1 < argc) config.tle_source_url = argv[++i]; }
+        else if (arg == "--sortby") { if (i+1 < argc) config.sort_by = sortKeyName(parseSortKey(argv[++i])); }
         else if (arg == "--visible" || arg == "-visible") {
             if (i+1 < argc) {
                 std::string val = argv[++i];
@@ -273,7 +264,9 @@ int main(int argc, char* argv[]) {
 
     try {
         std::cout << "Initializing TLE Manager..." << std::endl;
+        Scheduler scheduler;    // Sized to the hardware
         TLEManager tle_mgr("./tle_cache");
+        tle_mgr.setScheduler(&scheduler);
         if(refresh_tle) tle_mgr.clearCache();
 
         // --- PHASE 1: BUILDER MODE ---
@@ -287,8 +280,11 @@ int main(int argc, char* argv[]) {
         
         // --- PHASE 2: TRACKER MODE ---
         std::cout << "Loading TLEs..." << std::endl;
+        tle_mgr.setSourceUrl(config.tle_source_url);
         
         std::vector<Satellite> sats;
+        // Sun and Moon from --satsel; analytic, outside the catalog
+        std::vector<CelestialBody> bodies = CelestialBody::fromSelection(config.sat_selection);
         if (!config.sat_selection.empty()) {
              std::cout << "Loading specific satellites: " << config.sat_selection << "..." << std::endl;
              sats = tle_mgr.loadSpecificSats(config.sat_selection);
@@ -297,7 +293,7 @@ int main(int argc, char* argv[]) {
              sats = tle_mgr.loadGroups(config.group_selection);
         }
         
-        if (sats.empty()) { 
+        if (sats.empty() && bodies.empty()) { 
             std::cerr << "ERROR: No satellites loaded! Check network or groups." << std::endl; 
             Logger::log("ERROR: No satellites loaded");
             return 1; 
@@ -311,7 +307,6 @@ int main(int argc, char* argv[]) {
         Display display; 
         display.setBlocking(true); 
         
-        ThreadPool pool(4); 
         PassPredictor predictor(observer);
         
         std::unique_ptr<Rotator> rotator;
@@ -319,20 +314,57 @@ int main(int argc, char* argv[]) {
             rotator = std::make_unique<Rotator>(config.rotator_host, config.rotator_port);
         }
         
-        // Initial Pre-calculation
-        run_precalc(sats, observer, pool, config, std::chrono::system_clock::from_time_t(physics_epoch));
+        // SoA propagation engine for the per-tick pass
+        SatelliteBatch batch;
+        batch.build(sats);
+        // Pass predictions fill in the background, most relevant satellites first;
+        // the servers and the tick start right away and show the rest as pending
+        Precalc precalc(PASS_CACHE_PATH, scheduler);
+        precalc.start(sats, batch, observer, config, std::chrono::system_clock::from_time_t(physics_epoch), web_server.getSelectedNoradId());
+        // Keeps every pass list HORIZON_MINS ahead as physics time advances
+        PassHorizon horizon;
+        TickPipeline tick(scheduler);
+        TickPipeline::Output tick_out;
 
         web_server.start();
         text_server.start();
 
         auto last_calc_time = Clock::now();
         bool first_run = true;
-        SharedState state;
+        // Immutable per-tick frames, read lock-free by the UI loop, web and text servers
+        FrameChannel frames;
+        web_server.setFrameSource(&frames);
+        text_server.setFrameSource(&frames);
+        uint64_t frame_seq = 0;
+        // Catalog-wide pass index. The horizon only ever adds passes at its far
+        // end, so a snapshot rebuilt once a minute still answers near-term queries.
+        TimelinePtr timeline;
+        auto last_timeline_build = std::chrono::steady_clock::time_point{};
+        // Objects out of propagation; the list is rebuilt only when the count moves
+        std::shared_ptr<const std::string> quarantine_json;
+        int last_quarantined = -1;
         std::atomic<bool> running(true);
 
+        // Reloads run off the math thread and are diffed into the live catalog,
+        // so unchanged satellites keep their passes and the tick never stalls.
+        // An external fetcher can drop new files into the cache to trigger one.
+        std::future<std::vector<Satellite>> pending_load;
+        bool reload_queued = false;
+        CacheWatcher cache_watcher("./tle_cache");
+        // Stale groups (see isCacheFresh) are refetched with conditional requests;
+        // the cache is only wiped by an explicit --refresh at start-up
+        auto start_load = [&]() {
+            tle_mgr.setSourceUrl(config.tle_source_url);
+            std::string sat_sel = config.sat_selection, group_sel = config.group_selection;
+            pending_load = std::async(std::launch::async, [&tle_mgr, sat_sel, group_sel]() {
+                return sat_sel.empty() ? tle_mgr.loadGroups(group_sel) : tle_mgr.loadSpecificSats(sat_sel);
+            });
+        };
+
         // BACKGROUND MATH THREAD
         std::thread math_thread([&]() {
             auto last_tle_refresh = std::chrono::steady_clock::now();
+            auto last_cache_poll = last_tle_refresh;
 
             while(running) {
                 // CALCULATE PHYSICS TIME (Decoupled)
@@ -343,14 +375,13 @@ int main(int argc, char* argv[]) {
 
                 // AUTO-REFRESH / HOT-RELOAD LOGIC
                 bool perform_reload = false;
-                bool force_refresh = false;
 
                 // 1. Check Schedule (Daily TLE Update)
                 auto now_steady = std::chrono::steady_clock::now();
                 if (now_steady - last_tle_refresh > std::chrono::hours(24)) {
                     Logger::log("Scheduled Daily TLE Refresh...");
+                    // Every group is past its 24 h freshness by now; unchanged ones answer 304
                     perform_reload = true;
-                    force_refresh = true;
                     last_tle_refresh = now_steady;
                 }
 
@@ -360,8 +391,23 @@ int main(int argc, char* argv[]) {
                     bool selection_changed = (new_cfg.group_selection != config.group_selection) ||
                                              (new_cfg.sat_selection != config.sat_selection);
 
+                    Observer next_observer(new_cfg.lat, new_cfg.lon, new_cfg.alt);
+                    // Passes, reach and the cache key all depend on the site and min_el
+                    bool predictions_stale = PassCache::makeKey(next_observer.getLocation(), new_cfg) != precalc.key();
+
                     config = new_cfg;
-                    observer = Observer(config.lat, config.lon, config.alt);
+                    observer = next_observer;
+                    // New observer or selection: rise/set times are searched again
+                    bodies = CelestialBody::fromSelection(config.sat_selection);
+
+                    if (predictions_stale) {
+                        Logger::log("Observer or min_el changed: recomputing all pass predictions");
+                        precalc.cancel();
+                        for (auto& sat : sats) sat.clearPredictions();
+                        horizon.reset();
+                        timeline.reset();
+                        precalc.start(sats, batch, observer, config, now, web_server.getSelectedNoradId());
+                    }
 
                     if (selection_changed) {
                          Logger::log("Hot Reload: Switching selection...");
@@ -369,117 +415,75 @@ int main(int argc, char* argv[]) {
                     }
                 }
 
+                // 3. Check for element files changed on disk (our own loads rewrite them too)
+                if (!pending_load.valid() && now_steady - last_cache_poll > std::chrono::seconds(5)) {
+                    last_cache_poll = now_steady;
+                    if (cache_watcher.poll()) {
+                        Logger::log("Hot Reload: TLE cache changed on disk");
+                        perform_reload = true;
+                    }
+                }
+
                 if (perform_reload) {
-                     if (force_refresh) tle_mgr.clearCache();
-
-                     // SAFETY: Clear active_sats pointers in SharedState BEFORE destroying sats vector.
-                     {
-                         std::lock_guard<std::mutex> lock(state.mutex);
-                         state.active_sats.clear();
-                         state.rows.clear();
-                         state.updated = false;
+                     if (pending_load.valid()) {
+                         // One load at a time; run again with the latest selection afterwards
+                         reload_queued = true;
+                     } else {
+                         start_load();
                      }
+                }
 
-                     // Re-load
-                     if (!config.sat_selection.empty()) {
-                          sats = tle_mgr.loadSpecificSats(config.sat_selection);
+                if (pending_load.valid() && pending_load.wait_for(std::chrono::seconds(0)) == std::future_status::ready) {
+                     std::vector<Satellite> fresh = pending_load.get();
+                     cache_watcher.snapshot();
+                     if (fresh.empty() && bodies.empty()) {
+                         Logger::log("Reload returned no satellites; keeping the current catalog");
                      } else {
-                          sats = tle_mgr.loadGroups(config.group_selection);
+                         // The fill holds references into the old catalog
+                         precalc.cancel();
+                         CatalogDiff diff = mergeCatalog(sats, std::move(fresh));
+                         Logger::log("Catalog reload: " + std::to_string(diff.kept) + " kept, " + std::to_string(diff.changed) + " changed, " +
+                                     std::to_string(diff.added) + " added, " + std::to_string(diff.removed) + " removed");
+                         // The batch indexes the vector itself, so any swap rebuilds it
+                         if (diff.swapped) {
+                             batch.build(sats);
+                             horizon.reset();
+                             timeline.reset();
+                             last_quarantined = -1;
+                         }
+                         // Only new and changed satellites are pending
+                         precalc.start(sats, batch, observer, config, now, web_server.getSelectedNoradId());
+                     }
+                     if (reload_queued) {
+                         reload_queued = false;
+                         start_load();
                      }
-
-                     // Re-Run Pre-calc
-                     run_precalc(sats, observer, pool, config, now);
                 }
 
-                std::vector<DisplayRow> local_rows;
-                std::vector<Satellite*> local_sats;
-                
-                int rejected_apo = 0;
-                int rejected_el = 0;
-                int rejected_vis = 0;
-
                 int selected_norad_id = web_server.getSelectedNoradId();
-
-                for(auto& sat : sats) {
-                    if(!running) break;
-                    
-                    // 1. Strict Decay Filter: Satellites below 80km are considered decayed/invalid
-                    if (sat.getApogeeKm() < 80.0) {
-                        continue;
-                    }
-
-                    auto [pos, vel] = sat.propagate(now);
-                    auto look = observer.calculateLookAngle(pos, now);
-                    double rrate = observer.calculateRangeRate(pos, vel, now);
-
-                    // ROTATOR LOGIC (Always run for selected sat, regardless of display filters)
-                    if (rotator && rotator->isConnected() && sat.getNoradId() == selected_norad_id) {
-                        if (look.elevation >= config.rotator_min_el) {
-                            rotator->setPosition(look.azimuth, look.elevation);
-                        }
-                    }
-
-                    // 2. Visibility Calculation
-                    auto state = VisibilityCalculator::calculateState(pos, observer.getPositionECI(now), now, look.elevation);
-
-                    // 3. User Filters
-
-                    // VISIBILITY FILTER
-                    // If visible_only is TRUE, we skip if NOT visible.
-                    if (config.visible_only && state != VisibilityCalculator::State::VISIBLE) {
-                        rejected_vis++;
-                        continue;
-                    }
-
-                    // MIN ELEVATION FILTER
-                    if (look.elevation < config.min_el) {
-                        rejected_el++;
-                        continue;
-                    }
-
-                    // MAX APOGEE FILTER
-                    if (config.max_apo > 0 && sat.getApogeeKm() > config.max_apo) {
-                        rejected_apo++;
-                        continue;
-                    }
-
-                    // Flare Calculation (Only relevant if visible, but calculate anyway for status)
-                    int flare_status = 0;
-                    if (state == VisibilityCalculator::State::VISIBLE) {
-                        flare_status = VisibilityCalculator::checkFlare(pos, observer.getPositionECI(now), VisibilityCalculator::getSunPositionECI(now), sat.getApogeeKm());
+                precalc.prioritize(selected_norad_id);
+
+                // Propagate, transform, filter and select the top max_sats in parallel
+                // shards; rows come back in display order
+                PassHorizon::stepBodies(bodies, observer, now);
+                tick.run(sats, bodies, batch, observer, config, now, selected_norad_id, tick_out);
+                std::vector<DisplayRow> local_rows = std::move(tick_out.rows);
+                if (tick_out.stats.quarantined != last_quarantined) {
+                    if (tick_out.stats.quarantined > last_quarantined && last_quarantined >= 0) {
+                        Logger::log("Quarantined " + std::to_string(tick_out.stats.quarantined - last_quarantined) + " more satellites (" +
+                                    std::to_string(tick_out.stats.quarantined) + " total)");
                     }
+                    last_quarantined = tick_out.stats.quarantined;
+                    quarantine_json = std::make_shared<const std::string>(WebServer::buildQuarantineJson(sats));
+                }
 
-                    std::string next_event_str = "--";
-                    auto passes = sat.getPredictedPasses();
-
-                    // Find first future event
-                    for(const auto& p : passes) {
-                        long diff = std::chrono::duration_cast<std::chrono::seconds>(p.time - now).count();
-                        if (diff > 0) {
-                             int mm = diff / 60;
-                             int ss = diff % 60;
-
-                             std::stringstream ts;
-                             ts << (p.is_aos ? "AOS " : "LOS ");
-
-                             if (mm >= 60) {
-                                 int hh = mm / 60;
-                                 mm = mm % 60;
-                                 ts << hh << "h " << mm << "m";
-                             } else {
-                                 ts << mm << "m " << ss << "s";
-                             }
-                             next_event_str = ts.str();
-                             break;
-                        }
+                // ROTATOR LOGIC (Always run for selected sat, regardless of display filters)
+                if (rotator && rotator->isConnected() && tick_out.has_selected) {
+                    if (tick_out.selected_look.elevation >= config.rotator_min_el) {
+                        rotator->setPosition(tick_out.selected_look.azimuth, tick_out.selected_look.elevation);
                     }
-                        
-                    auto geo = sat.getGeodetic(now);
-                    local_rows.push_back({sat.getName(), look.azimuth, look.elevation, look.range, rrate, geo.lat_deg, geo.lon_deg, sat.getApogeeKm(), state, sat.getNoradId(), next_event_str, flare_status});
-                    // DO NOT push to local_sats yet. We are filtering/sorting local_rows first.
-                    // We must rebuild local_sats from local_rows after filtering to ensure synchronization.
                 }
-                
+
                 // DIAGNOSTICS: If empty list, report why
                 if(local_rows.empty() && !sats.empty()) {
                      // Only log periodically to avoid spam, or handle in UI
@@ -488,60 +492,32 @@ int main(int argc, char* argv[]) {
                 
                 if (!running) break;
 
-                // STABLE SORT: Prevents flickering
-                std::stable_sort(local_rows.begin(), local_rows.end(), [](const DisplayRow& a, const DisplayRow& b) { return a.el > b.el; });
-
-                // Enforce max_sats but PRESERVE Sun/Moon
-                size_t limit = (config.max_sats > 0) ? (size_t)config.max_sats : 5000;
-
-                if (local_rows.size() > limit) {
-                    std::vector<DisplayRow> kept;
-                    std::vector<DisplayRow> others;
-                    kept.reserve(limit);
-                    others.reserve(local_rows.size());
-
-                    // Prioritize Sun/Moon
-                    for(const auto& r : local_rows) {
-                        if (r.norad_id == -1 || r.norad_id == -2) kept.push_back(r);
-                        else others.push_back(r);
-                    }
-                    // Fill remaining
-                    for(const auto& r : others) {
-                        if (kept.size() < limit) kept.push_back(r);
-                        else break;
-                    }
-                    local_rows = kept;
-                    // Re-sort final list
-                    std::stable_sort(local_rows.begin(), local_rows.end(), [](const DisplayRow& a, const DisplayRow& b) { return a.el > b.el; });
-                }
-
-                // REBUILD ACTIVE SATS POINTERS TO MATCH FILTERED ROWS
-                // This ensures WebServer JSON (which might use active_sats for details)
-                // and UI are perfectly synchronized.
-                local_sats.clear();
-                local_sats.reserve(local_rows.size());
-
-                // Create a lookup map for speed? Or just brute force?
-                // Brute force search in 'sats' for each 'row' is O(N*M). N=100, M=5000. 500,000 ops. Fine.
-                // Better: Create a map of ID -> Satellite* first.
-                // Even Better: We know 'sats' indices? No.
-                // Just iterate:
-                for(const auto& r : local_rows) {
-                    // Find sat with r.norad_id in 'sats'
-                    for(auto& s : sats) {
-                        if (s.getNoradId() == r.norad_id) {
-                            local_sats.push_back(&s);
-                            break;
-                        }
-                    }
+                // Rebuilt more often while the background fill is still adding passes
+                auto timeline_age = precalc.running() ? std::chrono::seconds(5) : std::chrono::seconds(60);
+                if (!timeline || now_steady - last_timeline_build > timeline_age) {
+                    timeline = PassHorizon::buildTimeline(sats);
+                    last_timeline_build = now_steady;
                 }
 
-                {
-                    std::lock_guard<std::mutex> lock(state.mutex);
-                    state.rows = local_rows;
-                    state.active_sats = local_sats;
-                    state.updated = true;
-                }
+                // PUBLISH: one immutable frame per tick; JSON and text views are rendered
+                // here once instead of by each consumer
+                auto frame = std::make_shared<Frame>();
+                frame->seq = ++frame_seq;
+                frame->time = now;
+                frame->time_str = formatDisplayTime(display_epoch + elapsed_sec);
+                frame->observer = observer.getLocation();
+                frame->config = config;
+                frame->total_tracked = static_cast<int>(sats.size());
+                frame->quarantined = last_quarantined;
+                frame->quarantine_json = quarantine_json;
+                frame->rows = std::move(local_rows);
+                frame->json = WebServer::buildJson(frame->rows, frame->config, now, frame->time_str);
+                frame->text = Display::renderText(frame->rows, frame->observer, now, frame->time_str);
+                frame->timeline = timeline;
+                frames.publish(std::move(frame));
+
+                // Roll the pass horizon forward within a fixed slice of the tick
+                horizon.step(sats, observer, config, now, std::chrono::milliseconds(50));
                 
                 for(int i=0; i<20; ++i) { if(!running) break; std::this_thread::sleep_for(std::chrono::milliseconds(50)); }
             }
@@ -565,31 +541,25 @@ int main(int argc, char* argv[]) {
             // 2. Display Time (Face Value-aligned)
             std::time_t display_tt = display_epoch + elapsed_sec;
 
-            // CONSTRUCT STRING
-            std::string time_display_str;
-            {
-                std::tm tm_display;
-                gmtime_r(&display_tt, &tm_display);
-                char t_buf[64];
-                std::strftime(t_buf, sizeof(t_buf), "%Y-%m-%d %H:%M:%S LOC", &tm_display);
-                time_display_str = std::string(t_buf);
-            }
+            std::string time_display_str = formatDisplayTime(display_tt);
 
-            std::vector<DisplayRow> current_rows;
-            {
-                std::lock_guard<std::mutex> lock(state.mutex);
-                current_rows = state.rows;
-                if (state.updated) {
-                    web_server.updateData(current_rows, state.active_sats, config, physics_now, time_display_str);
-                }
+            // Latest frame by reference: no row copy, no lock shared with the math thread
+            auto frame = frames.latest();
+            if (frame) {
+                display.update(frame->rows, frame->observer, physics_now, frame->total_tracked, frame->quarantined, frame->rows.size(),
+                               !frame->config.visible_only, frame->config.min_el, time_display_str, frame->timeline.get());
+            } else {
+                static const std::vector<DisplayRow> no_rows;
+                display.update(no_rows, observer.getLocation(), physics_now, sats.size(), 0, 0, !config.visible_only, config.min_el, time_display_str, nullptr);
             }
-            display.update(current_rows, observer, physics_now, sats.size(), current_rows.size(), !config.visible_only, config.min_el, time_display_str);
-            text_server.updateData(display.getLastFrame()); 
         }
 
         web_server.stop();
         text_server.stop();
         if(math_thread.joinable()) math_thread.join();
+        precalc.cancel();
+        // Keep the rolled-forward horizon for the next start, under the key it was computed for
+        PassCache::save(PASS_CACHE_PATH, precalc.key(), sats);
         Logger::log("Shutdown Complete");
 
     } catch (const std::exception& e) {
@@ -0,0 +1,191 @@
+#include "pass_cache.hpp"
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+namespace ve {
+    // All records are 8-byte multiples, so the arrays that follow each other
+    // in the file stay aligned when mapped
+    struct PassCache::Header {
+        char magic[4];
+        uint32_t version;
+        double lat, lon, alt;
+        double min_el;
+        double tolerance_km;
+        uint64_t entry_count, pass_count, segment_count;
+    };
+    struct PassCache::Entry {
+        int32_t norad_id;
+        uint32_t reach;
+        uint64_t tle_hash;
+        int64_t until_ns;
+        uint64_t pass_begin, pass_count;
+        uint64_t segment_begin, segment_count;
+        double max_error_km;
+    };
+    struct PassCache::PassData {
+        int64_t aos_ns, tca_ns, los_ns;
+        double max_el;
+        double aos_az, tca_az, los_az;
+        uint32_t has_aos, has_los;
+    };
+
+    namespace {
+        constexpr char MAGIC[4] = {'V', 'E', 'P', 'C'};
+        constexpr uint32_t VERSION = 1;
+
+        int64_t toNs(const TimePoint& t) {
+            return std::chrono::duration_cast<std::chrono::nanoseconds>(t.time_since_epoch()).count();
+        }
+        TimePoint fromNs(int64_t ns) {
+            return TimePoint(std::chrono::duration_cast<Clock::duration>(std::chrono::nanoseconds(ns)));
+        }
+    }
+
+    bool PassCache::open(const Key& key) {
+        close();
+        if (!file_.open(path_) || file_.size() < sizeof(Header)) { close(); return false; }
+        const uint8_t* base = file_.data();
+
+        // 1. Header: format and the configuration the predictions depend on
+        const Header* h = reinterpret_cast<const Header*>(base);
+        bool ok = std::memcmp(h->magic, MAGIC, sizeof(MAGIC)) == 0 && h->version == VERSION &&
+                  h->lat == key.lat && h->lon == key.lon && h->alt == key.alt &&
+                  h->min_el == key.min_el && h->tolerance_km == key.tolerance_km;
+
+        // 2. Array sizes must add up to the file size exactly. The counts are
+        // untrusted: bound each by the file first so the products cannot wrap.
+        size_t body = file_.size() - sizeof(Header);
+        ok = ok && h->entry_count <= body / sizeof(Entry) && h->pass_count <= body / sizeof(PassData) &&
+             h->segment_count <= body / sizeof(ChebyshevEphemeris::Segment);
+        ok = ok && body == h->entry_count * sizeof(Entry) + h->pass_count * sizeof(PassData)
+                         + h->segment_count * sizeof(ChebyshevEphemeris::Segment);
+        if (!ok) { close(); return false; }
+        entries_ = reinterpret_cast<const Entry*>(base + sizeof(Header));
+        entry_count_ = h->entry_count;
+        passes_ = reinterpret_cast<const PassData*>(entries_ + entry_count_);
+        pass_count_ = h->pass_count;
+        segments_ = reinterpret_cast<const ChebyshevEphemeris::Segment*>(passes_ + pass_count_);
+        segment_count_ = h->segment_count;
+
+        // 3. Every entry in bounds, table sorted for the lookup
+        for (size_t i = 0; i < entry_count_ && ok; ++i) {
+            const Entry& e = entries_[i];
+            ok = e.reach <= static_cast<uint32_t>(Reach::ALWAYS) &&
+                 e.pass_begin <= pass_count_ && e.pass_count <= pass_count_ - e.pass_begin &&
+                 e.segment_begin <= segment_count_ && e.segment_count <= segment_count_ - e.segment_begin;
+            if (ok && i > 0) {
+                const Entry& p = entries_[i - 1];
+                ok = p.norad_id < e.norad_id || (p.norad_id == e.norad_id && p.tle_hash <= e.tle_hash);
+            }
+        }
+        if (!ok) { close(); return false; }
+        return true;
+    }
+
+    void PassCache::close() {
+        file_.close();
+        entries_ = nullptr; passes_ = nullptr; segments_ = nullptr;
+        entry_count_ = pass_count_ = segment_count_ = 0;
+    }
+
+    bool PassCache::restore(Satellite& sat, const TimePoint& now, int trail_mins) const {
+        if (!file_.isOpen()) return false;
+        const Header* h = reinterpret_cast<const Header*>(file_.data());
+
+        // 1. Entry for exactly these elements
+        int id = sat.getNoradId();
+        uint64_t hash = sat.getTleHash();
+        const Entry* end = entries_ + entry_count_;
+        const Entry* e = std::lower_bound(entries_, end, std::make_pair(id, hash), [](const Entry& a, const std::pair<int, uint64_t>& k) {
+            return a.norad_id < k.first || (a.norad_id == k.first && a.tle_hash < k.second);
+        });
+        if (e == end || e->norad_id != id || e->tle_hash != hash) return false;
+
+        // 2. Predictions must still reach well past now
+        TimePoint until = fromNs(e->until_ns);
+        if (until < now + std::chrono::minutes(MIN_AHEAD_MINS)) return false;
+
+        // 3. Ephemeris must cover the trail behind now
+        std::shared_ptr<ChebyshevEphemeris> eph;
+        if (h->tolerance_km > 0.0) {
+            eph = std::make_shared<ChebyshevEphemeris>();
+            std::vector<ChebyshevEphemeris::Segment> segs(segments_ + e->segment_begin, segments_ + e->segment_begin + e->segment_count);
+            double from = JulianTime::fromTimePoint(now - std::chrono::minutes(trail_mins)).minutesSince(sat.getEpoch());
+            if (!eph->assign(std::move(segs), e->max_error_km) || !eph->covers(from)) return false;
+        }
+
+        // 4. Passes that have not set yet
+        std::vector<Satellite::PassRecord> records;
+        records.reserve(e->pass_count);
+        for (const PassData* p = passes_ + e->pass_begin; p != passes_ + e->pass_begin + e->pass_count; ++p) {
+            TimePoint los = fromNs(p->los_ns);
+            if (p->has_los && los < now) continue;
+            records.push_back({fromNs(p->aos_ns), fromNs(p->tca_ns), los, p->max_el,
+                               p->aos_az, p->tca_az, p->los_az, p->has_aos != 0, p->has_los != 0});
+        }
+        if (eph) sat.setEphemeris(std::move(eph));
+        sat.setReach(static_cast<Reach>(e->reach));
+        sat.setPassRecords(records, until);
+        return true;
+    }
+
+    bool PassCache::save(const std::string& path, const Key& key, const std::vector<Satellite>& sats) {
+        std::vector<Entry> entries;
+        std::vector<PassData> passes;
+        std::vector<ChebyshevEphemeris::Segment> segments;
+        entries.reserve(sats.size());
+
+        // 1. Flatten every satellite's state
+        for (const auto& sat : sats) {
+            if (sat.getNoradId() == 0) continue;    // Element set failed to parse
+            if (!sat.hasPredictions()) continue;    // Still pending in the background fill
+            Entry e{};
+            e.norad_id = sat.getNoradId();
+            e.reach = static_cast<uint32_t>(sat.getReach());
+            e.tle_hash = sat.getTleHash();
+            e.until_ns = toNs(sat.getPredictedUntil());
+            e.pass_begin = passes.size();
+            for (const auto& r : sat.getPassRecords()) {
+                passes.push_back({toNs(r.aos), toNs(r.tca), toNs(r.los), r.max_el,
+                                  r.aos_az, r.tca_az, r.los_az, r.has_aos ? 1u : 0u, r.has_los ? 1u : 0u});
+            }
+            e.pass_count = passes.size() - e.pass_begin;
+            e.segment_begin = segments.size();
+            if (auto eph = sat.getEphemeris()) {
+                segments.insert(segments.end(), eph->segments().begin(), eph->segments().end());
+                e.max_error_km = eph->maxErrorKm();
+            }
+            e.segment_count = segments.size() - e.segment_begin;
+            entries.push_back(e);
+        }
+        std::sort(entries.begin(), entries.end(), [](const Entry& a, const Entry& b) {
+            return a.norad_id < b.norad_id || (a.norad_id == b.norad_id && a.tle_hash < b.tle_hash);
+        });
+
+        Header h{};
+        std::memcpy(h.magic, MAGIC, sizeof(MAGIC));
+        h.version = VERSION;
+        h.lat = key.lat; h.lon = key.lon; h.alt = key.alt;
+        h.min_el = key.min_el;
+        h.tolerance_km = key.tolerance_km;
+        h.entry_count = entries.size();
+        h.pass_count = passes.size();
+        h.segment_count = segments.size();
+
+        // 2. Write beside the old file, then swap it in
+        std::string tmp = path + ".tmp";
+        FILE* f = std::fopen(tmp.c_str(), "wb");
+        if (!f) return false;
+        bool ok = std::fwrite(&h, sizeof(h), 1, f) == 1;
+        ok = ok && std::fwrite(entries.data(), sizeof(Entry), entries.size(), f) == entries.size();
+        ok = ok && std::fwrite(passes.data(), sizeof(PassData), passes.size(), f) == passes.size();
+        ok = ok && std::fwrite(segments.data(), sizeof(ChebyshevEphemeris::Segment), segments.size(), f) == segments.size();
+        ok = (std::fclose(f) == 0) && ok;
+        if (!ok || std::rename(tmp.c_str(), path.c_str()) != 0) {
+            std::remove(tmp.c_str());
+            return false;
+        }
+        return true;
+    }
+}
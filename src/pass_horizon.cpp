@@ -0,0 +1,84 @@
+#include "pass_horizon.hpp"
+#include "pass_predictor.hpp"
+#include "ephemeris.hpp"
+
+namespace ve {
+    namespace {
+        // Extra span fitted past the search front, so a refit lasts several chunks
+        constexpr double REFIT_AHEAD_MINS = 360.0;
+    }
+
+    int PassHorizon::step(std::vector<Satellite>& sats, const Observer& obs, const AppConfig& cfg,
+                          const TimePoint& now, std::chrono::milliseconds budget) {
+        if (sats.empty()) return 0;
+        auto deadline = std::chrono::steady_clock::now() + budget;
+        TimePoint due = now + std::chrono::minutes(HORIZON_MINS - CHUNK_MINS);
+        int extended = 0;
+
+        for (size_t n = 0; n < sats.size(); ++n) {
+            if (std::chrono::steady_clock::now() >= deadline) break;
+            cursor_ %= sats.size();
+            Satellite& sat = sats[cursor_++];
+            if (sat.isQuarantined()) continue;          // Decayed or not propagatable
+            if (!sat.hasPredictions()) continue;        // Owned by the background precalc until it lands
+            if (sat.getPredictedUntil() >= due) continue;
+            extend(sat, obs, cfg, now);
+            extended++;
+        }
+        return extended;
+    }
+
+    TimelinePtr PassHorizon::buildTimeline(const std::vector<Satellite>& sats) {
+        std::vector<EventTimeline::Pass> passes;
+        std::vector<std::string> names;
+        names.reserve(sats.size());
+        for (const auto& sat : sats) {
+            uint32_t idx = static_cast<uint32_t>(names.size());
+            names.emplace_back(sat.getName());
+            for (const auto& r : sat.getPassRecords()) {
+                passes.push_back({sat.getNoradId(), idx, r.aos, r.tca, r.los, r.max_el,
+                                  r.aos_az, r.tca_az, r.los_az, r.has_aos, r.has_los});
+            }
+        }
+        return std::make_shared<const EventTimeline>(std::move(passes), std::move(names));
+    }
+
+    void PassHorizon::stepBodies(std::vector<CelestialBody>& bodies, const Observer& obs, const TimePoint& now) {
+        for (auto& body : bodies) {
+            if (body.getPredictedUntil() >= now + std::chrono::minutes(HORIZON_MINS)) continue;
+            PassPredictor predictor(obs);
+            std::vector<CelestialBody::PassEvent> events;
+            for (const auto& p : predictor.predictPasses(body, now, BODY_HORIZON_MINS)) {
+                if (p.has_aos) events.push_back({p.aos, true});
+                if (p.has_los) events.push_back({p.los, false});
+            }
+            body.setPassEvents(std::move(events), now + std::chrono::minutes(BODY_HORIZON_MINS));
+        }
+    }
+
+    void PassHorizon::extend(Satellite& sat, const Observer& obs, const AppConfig& cfg, const TimePoint& now) {
+        // A list that fell entirely behind (long stall, new object) restarts at now
+        TimePoint from = sat.getPredictedUntil();
+        bool fresh = from < now;
+        if (fresh) from = now;
+        TimePoint to = from + std::chrono::minutes(CHUNK_MINS);
+
+        // 1. Keep the state cache ahead of the search front
+        if (cfg.ephemeris_tolerance_km > 0.0) {
+            auto eph = sat.getEphemeris();
+            if (eph && !eph->covers(JulianTime::fromTimePoint(to).minutesSince(sat.getEpoch()))) {
+                auto fit_start = now - std::chrono::minutes(cfg.trail_length_mins);
+                double span = std::chrono::duration<double, std::ratio<60>>(to - fit_start).count()
+                            + REFIT_AHEAD_MINS + cfg.trail_length_mins;
+                sat.setEphemeris(sat.fitEphemeris(fit_start, span, cfg.ephemeris_tolerance_km));
+            }
+        }
+
+        // 2. Search the next chunk
+        PassPredictor predictor(obs);
+        Reach reach = predictor.classify(sat, from, CHUNK_MINS, cfg.min_el);
+        auto passes = predictor.predictPasses(sat, from, CHUNK_MINS, reach);
+        if (fresh) sat.setPassRecords(passes, to);
+        else sat.extendPassRecords(passes, to, now);
+    }
+}
@@ -1,8 +1,15 @@
 #include "pass_predictor.hpp"
 #include <iostream>
+#include <algorithm>
+#include <cmath>
 
 namespace ve {
-    PassPredictor::PassPredictor(const Observer& obs) : observer_(obs) {}
+    namespace {
+        constexpr double MIN_STEP = 10.0;
+        constexpr double MAX_STEP = 1800.0;
+    }
+
+    PassPredictor::PassPredictor(const Observer& obs, Mode mode) : observer_(obs), mode_(mode) {}
 
     double PassPredictor::getElevation(const Satellite& sat, const TimePoint& t) {
         auto [pos, vel] = sat.propagate(t);
@@ -11,15 +18,15 @@ namespace ve {
 
     TimePoint PassPredictor::solveNewton(const Satellite& sat, TimePoint initial_guess) {
         TimePoint t = initial_guess;
-        double epsilon = 0.01; 
+        double epsilon = 0.01;
         int max_iter = 10;
         for(int i=0; i<max_iter; ++i) {
             double el = getElevation(sat, t);
             if (std::abs(el) < epsilon) return t;
             TimePoint t_plus = t + std::chrono::seconds(1);
             double el_plus = getElevation(sat, t_plus);
-            double deriv = (el_plus - el); 
-            if (std::abs(deriv) < 1e-5) break; 
+            double deriv = (el_plus - el);
+            if (std::abs(deriv) < 1e-5) break;
             double delta_sec = el / deriv;
             if (delta_sec > 600) delta_sec = 600; if (delta_sec < -600) delta_sec = -600;
             t = t - std::chrono::milliseconds((long)(delta_sec * 1000));
@@ -29,15 +36,23 @@ namespace ve {
 
     std::vector<Satellite::PassEvent> PassPredictor::predict(Satellite& sat, const TimePoint& start, int search_window_mins) {
         std::vector<Satellite::PassEvent> results;
+        if (mode_ == Mode::ADAPTIVE) {
+            for (const auto& p : predictPasses(sat, start, search_window_mins)) {
+                if (p.has_aos) results.push_back({p.aos, true});
+                if (p.has_los) results.push_back({p.los, false});
+            }
+            return results;
+        }
+
         TimePoint t = start;
         TimePoint end = start + std::chrono::minutes(search_window_mins);
-        auto step = std::chrono::minutes(2); 
+        auto step = std::chrono::minutes(2);
         double prev_el = getElevation(sat, t);
-        
+
         while (t < end) {
             TimePoint next_t = t + step;
             double next_el = getElevation(sat, next_t);
-            
+
             if ((prev_el < 0 && next_el >= 0) || (prev_el >= 0 && next_el < 0)) {
                 TimePoint crossing = solveNewton(sat, t + step/2);
                 double el_check = getElevation(sat, crossing + std::chrono::seconds(1));
@@ -50,4 +65,166 @@ namespace ve {
         }
         return results;
     }
+
+    Reach PassPredictor::classify(const Satellite& sat, const TimePoint& start, int search_window_mins, double min_el) const {
+        Sgp4Elements elems = sat.getSgp4Elements();
+        double el_now = observer_.calculateLookAngle(sat.propagate(start).first, start).elevation;
+        Geodetic loc = observer_.getLocation();
+        if (classifyReach(elems, loc, std::max(min_el, 0.0), search_window_mins, el_now) == Reach::NEVER) return Reach::NEVER;
+        return (classifyReach(elems, loc, 0.0, search_window_mins, el_now) == Reach::ALWAYS) ? Reach::ALWAYS : Reach::PASS_CAPABLE;
+    }
+
+    std::vector<Satellite::PassRecord> PassPredictor::predictPasses(const Satellite& sat, const TimePoint& start, int search_window_mins, Reach reach) {
+        if (reach == Reach::NEVER) return {};
+        auto look = [&](double s) {
+            TimePoint t = start + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(s));
+            return observer_.calculateLookAngle(sat.propagate(t).first, t);
+        };
+
+        // Step sizes from the orbit.
+        // Below the horizon elevation changes no faster than the central angle between
+        // observer and sub-satellite point, which moves at most at the perigee angular
+        // rate plus Earth rotation: stepping by margin / rate cannot skip a rise.
+        // Above it the pass is a single rise and set and the next rise is far more
+        // than 1/8 orbit away, so a fixed step only has to bracket the set.
+        Sgp4Elements elems = sat.getSgp4Elements();
+        double n = elems.mean_motion / 60.0;                        // rad/s
+        if (n <= 0.0) return {};
+        double e = std::clamp(elems.eccentricity, 0.0, 0.99);
+        double w = n * (1.0 + e) * (1.0 + e) / std::pow(1.0 - e * e, 1.5) + 7.2921159e-5;
+        double step_up = std::clamp(2.0 * PI / n / 8.0, MIN_STEP, MAX_STEP);
+        return scanPasses(start, search_window_mins * 60.0, look, 1.1 * w * RAD2DEG, step_up, reach == Reach::ALWAYS);
+    }
+
+    std::vector<Satellite::PassRecord> PassPredictor::predictPasses(const CelestialBody& body, const TimePoint& start, int search_window_mins) {
+        auto look = [&](double s) {
+            TimePoint t = start + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(s));
+            return observer_.calculateLookAngle(body.positionEci(t), t);
+        };
+        // Diurnal motion (plus the Moon's own ~0.5 deg/h) bounds the rate; days are
+        // hours long, so a 10 minute step above the horizon still brackets the set
+        constexpr double DIURNAL_DEG_S = 360.0 / 86164.1;
+        return scanPasses(start, search_window_mins * 60.0, look, 1.1 * DIURNAL_DEG_S + 0.5 / 3600.0, 600.0, false);
+    }
+
+    std::vector<Satellite::PassRecord> PassPredictor::scanPasses(const TimePoint& start, double span, const LookFn& look,
+                                                                 double rate_below, double step_up, bool always_up) {
+        std::vector<Satellite::PassRecord> passes;
+        auto at = [&start](double s) {
+            return start + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(s));
+        };
+        ElevationFn el = [&](double s) { return look(s).elevation; };
+
+        // Scan, refining each horizon crossing inside its bracket
+        auto finish = [&](double aos_s, bool has_aos, double los_s, bool has_los) {
+            Satellite::PassRecord p;
+            double tca_s = findCulmination(el, aos_s, los_s);
+            auto la = look(aos_s); auto lt = look(tca_s); auto ll = look(los_s);
+            // A pass clipped by the window may culminate on the edge itself
+            if (!has_aos && la.elevation > lt.elevation) { tca_s = aos_s; lt = la; }
+            if (!has_los && ll.elevation > lt.elevation) { tca_s = los_s; lt = ll; }
+            p.aos = at(aos_s); p.tca = at(tca_s); p.los = at(los_s);
+            p.max_el = lt.elevation;
+            p.aos_az = la.azimuth; p.tca_az = lt.azimuth; p.los_az = ll.azimuth;
+            p.has_aos = has_aos; p.has_los = has_los;
+            passes.push_back(p);
+        };
+
+        if (always_up) {
+            finish(0.0, false, span, false);
+            return passes;
+        }
+
+        double t = 0.0;
+        double f = el(t);
+        bool in_pass = (f >= 0.0);
+        double aos_s = 0.0;
+        bool has_aos = false;
+
+        while (t < span) {
+            double step = (f >= 0.0) ? step_up : std::clamp(-f / rate_below, MIN_STEP, MAX_STEP);
+            double tn = std::min(t + step, span);
+            double fn = el(tn);
+            if ((f < 0.0) != (fn < 0.0)) {
+                double tc = findCrossing(el, t, f, tn, fn);
+                if (fn >= 0.0) {
+                    in_pass = true; aos_s = tc; has_aos = true;
+                } else if (in_pass) {
+                    finish(aos_s, has_aos, tc, true);
+                    in_pass = false;
+                }
+            }
+            t = tn; f = fn;
+        }
+        if (in_pass) finish(aos_s, has_aos, span, false);
+        return passes;
+    }
+
+    double PassPredictor::findCrossing(const ElevationFn& el, double a, double fa, double b, double fb) {
+        // Illinois variant of regula falsi: halve the stale endpoint's value when the
+        // same side is kept twice, falling back to bisection if the secant leaves the bracket.
+        int side = 0;
+        double c = a;
+        for (int i = 0; i < 50 && (b - a) > 0.5; ++i) {
+            c = (a * fb - b * fa) / (fb - fa);
+            if (!(c > a && c < b)) c = 0.5 * (a + b);
+            double fc = el(c);
+            if (std::abs(fc) < 1e-3) return c;
+            if ((fc < 0.0) == (fb < 0.0)) {
+                b = c; fb = fc;
+                if (side == -1) fa *= 0.5;
+                side = -1;
+            } else {
+                a = c; fa = fc;
+                if (side == 1) fb *= 0.5;
+                side = 1;
+            }
+        }
+        return c;
+    }
+
+    double PassPredictor::findCulmination(const ElevationFn& el, double a, double b) {
+        // Brent's method (golden section + parabolic interpolation) on -elevation,
+        // converged to about a second
+        const double CGOLD = 0.3819660;
+        const double tol = 0.5;
+        double x = a + CGOLD * (b - a), w = x, v = x;
+        double fx = -el(x), fw = fx, fv = fx;
+        double d = 0.0, e = 0.0;
+        for (int iter = 0; iter < 100; ++iter) {
+            double xm = 0.5 * (a + b);
+            if (std::abs(x - xm) <= 2.0 * tol - 0.5 * (b - a)) break;
+            bool golden = true;
+            if (std::abs(e) > tol) {
+                double r = (x - w) * (fx - fv);
+                double q = (x - v) * (fx - fw);
+                double p = (x - v) * q - (x - w) * r;
+                q = 2.0 * (q - r);
+                if (q > 0.0) p = -p; else q = -q;
+                double e_prev = e;
+                e = d;
+                if (std::abs(p) < std::abs(0.5 * q * e_prev) && p > q * (a - x) && p < q * (b - x)) {
+                    d = p / q;
+                    double u = x + d;
+                    if (u - a < 2.0 * tol || b - u < 2.0 * tol) d = (xm >= x) ? tol : -tol;
+                    golden = false;
+                }
+            }
+            if (golden) {
+                e = (x >= xm) ? a - x : b - x;
+                d = CGOLD * e;
+            }
+            double u = (std::abs(d) >= tol) ? x + d : x + ((d >= 0.0) ? tol : -tol);
+            double fu = -el(u);
+            if (fu <= fx) {
+                if (u >= x) a = x; else b = x;
+                v = w; fv = fw; w = x; fw = fx; x = u; fx = fu;
+            } else {
+                if (u < x) a = u; else b = u;
+                if (fu <= fw || w == x) { v = w; fv = fw; w = u; fw = fu; }
+                else if (fu <= fv || v == x || v == w) { v = u; fv = fu; }
+            }
+        }
+        return x;
+    }
 }
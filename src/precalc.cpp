@@ -0,0 +1,164 @@
+#include "precalc.hpp"
+#include "pass_predictor.hpp"
+#include "pass_horizon.hpp"
+#include "ephemeris.hpp"
+#include "frame_context.hpp"
+#include "logger.hpp"
+#include <algorithm>
+
+namespace ve {
+    Precalc::Precalc(std::string cache_path, Scheduler& scheduler) : cache_path_(std::move(cache_path)), scheduler_(scheduler) {}
+
+    void Precalc::start(std::vector<Satellite>& sats, SatelliteBatch& batch, const Observer& obs, const AppConfig& cfg,
+                        const TimePoint& now, int selected_norad_id) {
+        cancel();
+        sats_ = &sats;
+        obs_ = std::make_unique<Observer>(obs);
+        cfg_ = cfg;
+        start_time_ = now;
+        started_ = std::chrono::steady_clock::now();
+
+        // Entries a previous run saved for the same elements and observer are restored as-is
+        key_ = PassCache::makeKey(obs.getLocation(), cfg);
+        cache_ = std::make_unique<PassCache>(cache_path_);
+        cache_->open(key_);
+
+        rank(batch, selected_norad_id);
+        claimed_.reset(new std::atomic<bool>[sats.size()]);
+        for (size_t i = 0; i < sats.size(); ++i) claimed_[i].store(false);
+        cursor_ = 0;
+        urgent_ = 0;
+        completed_ = 0;
+        restored_ = 0;
+        cancel_ = false;
+        if (order_.empty()) return;
+
+        Logger::log("Pre-calculating passes for " + std::to_string(order_.size()) + " satellites in the background");
+        // One item per satellite, one satellite per chunk. The tick thread never
+        // runs fill chunks, and a tick's chunks wait behind at most the one
+        // pass search each worker is in the middle of.
+        remaining_ = order_.size();
+        fill_ = scheduler_.submit(order_.size(), 1, [this](size_t begin, size_t end) {
+            for (size_t k = begin; k < end; ++k) next();
+        });
+    }
+
+    void Precalc::prioritize(int norad_id) {
+        if (norad_id != 0 && running()) urgent_.store(norad_id);
+    }
+
+    void Precalc::cancel() {
+        cancel_ = true;
+        fill_.reset();      // Waits for the chunks still queued; they return at once
+    }
+
+    void Precalc::rank(SatelliteBatch& batch, int selected_norad_id) {
+        const auto& sats = *sats_;
+        // 1. Where everything is at the start time, on the pool
+        scheduler_.parallel_for(batch.size(), 256, [&](size_t begin, size_t end) { batch.propagate(start_time_, begin, end); });
+        FrameContext frame(start_time_, *obs_, &batch);
+
+        struct Rank { int tier; double el; size_t index; };
+        std::vector<Rank> ranks;
+        ranks.reserve(sats.size());
+        for (size_t i = 0; i < sats.size(); ++i) {
+            const Satellite& sat = sats[i];
+            if (sat.hasPredictions()) continue;     // Carried over by a catalog reload
+            if (sat.isQuarantined()) continue;
+            int tier = 3;
+            double el = -90.0;
+            if (sat.getNoradId() == selected_norad_id) {
+                tier = 0;
+            } else if (batch.ok(i)) {
+                // 2. Whether it is up now or closing in
+                Vector3 pos = batch.position(i);
+                el = obs_->calculateLookAngle(pos, frame).elevation;
+                if (el >= 0.0) tier = 1;
+                else if (obs_->calculateRangeRate(pos, batch.velocity(i), frame) < 0.0) tier = 2;
+            }
+            ranks.push_back({tier, el, i});
+        }
+        std::stable_sort(ranks.begin(), ranks.end(), [](const Rank& a, const Rank& b) {
+            return (a.tier != b.tier) ? a.tier < b.tier : a.el > b.el;
+        });
+        order_.clear();
+        order_.reserve(ranks.size());
+        for (const auto& r : ranks) order_.push_back(r.index);
+    }
+
+    void Precalc::next() {
+        // Fill items are interchangeable: each takes the most urgent satellite left
+        if (!cancel_) {
+            // 1. A satellite bumped by prioritize() goes first
+            int urgent = urgent_.exchange(0);
+            if (urgent != 0) {
+                auto& sats = *sats_;
+                for (size_t i = 0; i < sats.size(); ++i) {
+                    if (sats[i].getNoradId() == urgent) {
+                        if (!claimed_[i].exchange(true)) process(i);
+                        break;
+                    }
+                }
+            }
+            // 2. Then the next unclaimed satellite in rank order
+            for (size_t k = cursor_.fetch_add(1); k < order_.size(); k = cursor_.fetch_add(1)) {
+                size_t i = order_[k];
+                if (!claimed_[i].exchange(true)) { process(i); break; }
+            }
+        }
+        if (remaining_.fetch_sub(1) == 1) finish();
+    }
+
+    void Precalc::process(size_t i) {
+        Satellite& sat = (*sats_)[i];
+        if (sat.isQuarantined()) return;        // Urgent pick of an object that cannot be propagated
+        // The fill runs while physics time moves on; work from where it is now
+        TimePoint now = physicsNow();
+
+        if (cache_->restore(sat, now, cfg_.trail_length_mins)) {
+            restored_++;
+        } else {
+            // Fit the state cache first so pass search and trails run off polynomials.
+            // Span covers the trail behind now and the pass horizon ahead.
+            if (cfg_.ephemeris_tolerance_km > 0.0) {
+                auto fit_start = now - std::chrono::minutes(cfg_.trail_length_mins);
+                double horizon = PassHorizon::HORIZON_MINS + 2.0 * cfg_.trail_length_mins;
+                sat.setEphemeris(sat.fitEphemeris(fit_start, horizon, cfg_.ephemeris_tolerance_km));
+            }
+            // The fit is the first libsgp4 run for deep-space objects; it may have failed
+            if (sat.isQuarantined()) { completed_++; return; }
+            // Objects that provably never rise (or never set) skip the pass search
+            PassPredictor predictor(*obs_);
+            Reach reach = predictor.classify(sat, now, PassHorizon::HORIZON_MINS, cfg_.min_el);
+            sat.setReach(reach);
+            auto passes = predictor.predictPasses(sat, now, PassHorizon::HORIZON_MINS, reach);
+            sat.setPassRecords(passes, now + std::chrono::minutes(PassHorizon::HORIZON_MINS));
+        }
+        sat.calculateGroundTrack(now, cfg_.trail_length_mins, 60);
+        completed_++;
+    }
+
+    void Precalc::finish() {
+        cache_->close();
+        if (cancel_) return;
+
+        int never = 0, always = 0, quarantined = 0;
+        for (const auto& sat : *sats_) {
+            if (sat.isQuarantined()) quarantined++;
+            else if (sat.getReach() == Reach::NEVER) never++;
+            else if (sat.getReach() == Reach::ALWAYS) always++;
+        }
+        double secs = std::chrono::duration<double>(std::chrono::steady_clock::now() - started_).count();
+        Logger::log("Pre-calculation complete in " + std::to_string(secs) + " s (" + std::to_string(restored_.load()) + " from cache, " +
+                    std::to_string(never) + " never rise, " + std::to_string(always) + " always up, " +
+                    std::to_string(quarantined) + " quarantined)");
+
+        if (restored_ < completed_ && !PassCache::save(cache_path_, key_, *sats_)) {
+            Logger::log("Could not write pass cache " + cache_path_);
+        }
+    }
+
+    TimePoint Precalc::physicsNow() const {
+        return start_time_ + std::chrono::duration_cast<Clock::duration>(std::chrono::steady_clock::now() - started_);
+    }
+}
@@ -0,0 +1,68 @@
+#include "reach.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace ve {
+    namespace {
+        constexpr double EARTH_ROTATION = 7.2921159e-5;    // rad/s
+        constexpr double WGS72_F = 1.0 / 298.26;
+        constexpr double ANGLE_MARGIN = 0.5 * DEG2RAD;      // Oblateness, geodetic vs geocentric vertical
+        constexpr double RADIUS_MARGIN = 0.01;              // Short-period terms and a day of decay
+        constexpr double SYNC_MAX_WANDER = 0.2;             // rad; beyond this the orbit is not "parked"
+
+        // Largest central angle at which a satellite at radius r is at or above
+        // elevation eps for an observer at radius ro
+        double coverageAngle(double r, double ro, double eps) {
+            double c = ro * std::cos(eps) / r;
+            if (c >= 1.0) return 0.0;
+            return std::max(0.0, std::acos(c) - eps);
+        }
+    }
+
+    Reach classifyReach(const Sgp4Elements& el, const Geodetic& observer, double mask_deg,
+                        double window_mins, double el_now_deg) {
+        if (el.mean_motion <= 0.0) return Reach::PASS_CAPABLE;
+
+        // 1. Orbit size (SGP4 mean motion is rad/min)
+        double n = el.mean_motion / 60.0;
+        double a = std::cbrt(SGP4_MU / (n * n));
+        double e = std::clamp(el.eccentricity, 0.0, 0.999);
+        double r_apo = a * (1.0 + e) * (1.0 + RADIUS_MARGIN);
+        double r_peri = a * (1.0 - e) * (1.0 - RADIUS_MARGIN);
+
+        // 2. Observer on the WGS-72 ellipsoid, geocentric latitude
+        double lat = observer.lat_deg * DEG2RAD;
+        double lat_c = std::atan((1.0 - WGS72_F) * (1.0 - WGS72_F) * std::tan(lat));
+        double s = std::sin(lat);
+        double ro = SGP4_XKMPER * (1.0 - WGS72_F * s * s) + observer.alt_km;
+        double mask = mask_deg * DEG2RAD;
+
+        if (r_apo <= ro) return Reach::NEVER;
+
+        // 3. Latitude reach: the sub-satellite point never leaves |lat| <= i (or 180 - i
+        // retrograde), so the closest it gets to the observer is |lat_c| - i
+        double incl = std::min(el.inclination, PI - el.inclination);
+        double closest = std::abs(lat_c) - incl;
+        if (closest - ANGLE_MARGIN > coverageAngle(r_apo, ro, mask)) return Reach::NEVER;
+
+        // 4. Near-synchronous: over the window the sub-satellite point stays within
+        // its longitude drift plus the daily figure-eight (inclination) and libration
+        // (eccentricity). Elevation changes at most r / (r - ro) times the central angle.
+        double drift = std::abs(n - EARTH_ROTATION) * window_mins * 60.0;
+        double wander = drift + 2.0 * (incl + 2.0 * e + 0.25 * incl * incl);
+        if (wander < SYNC_MAX_WANDER && r_peri > ro) {
+            double swing = (wander * r_peri / (r_peri - ro) + ANGLE_MARGIN) * RAD2DEG;
+            if (el_now_deg - swing >= mask_deg) return Reach::ALWAYS;
+            if (el_now_deg + swing < mask_deg) return Reach::NEVER;
+        }
+        return Reach::PASS_CAPABLE;
+    }
+
+    const char* reachName(Reach r) {
+        switch (r) {
+            case Reach::NEVER: return "never";
+            case Reach::ALWAYS: return "always";
+            default: return "pass";
+        }
+    }
+}
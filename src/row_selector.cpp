@@ -0,0 +1,19 @@
+#include "row_selector.hpp"
+
+namespace ve {
+    SortKey parseSortKey(const std::string& name) {
+        if (name == "range") return SortKey::RANGE;
+        if (name == "aos") return SortKey::NEXT_AOS;
+        if (name == "flare") return SortKey::FLARE;
+        return SortKey::ELEVATION;
+    }
+
+    const char* sortKeyName(SortKey key) {
+        switch (key) {
+            case SortKey::RANGE: return "range";
+            case SortKey::NEXT_AOS: return "aos";
+            case SortKey::FLARE: return "flare";
+            default: return "el";
+        }
+    }
+}
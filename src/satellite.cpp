@@ -1,119 +1,321 @@
 #include "satellite.hpp"
+#include "ephemeris.hpp"
 #include <iostream>
+#include <algorithm>
 #include <sstream>
-#include <ctime>
-#include <iomanip>
 #include <CoordTopocentric.h>
 #include <CoordGeodetic.h>
+#include <DecayedException.h>
 
 namespace ve {
-    Satellite::Satellite(std::string name, std::string line1, std::string line2) 
-        : name_(std::move(name)), is_computing(false) {
+    namespace {
+        uint64_t fnv1a(std::string_view s, uint64_t h = 14695981039346656037ull) {
+            for (unsigned char c : s) { h ^= c; h *= 1099511628211ull; }
+            return h;
+        }
+        // The two searches either side of a seam may disagree on the sign of the
+        // elevation there (root tolerance, ephemeris refit); crossings this close
+        // to the seam are the same crossing
+        constexpr auto SEAM_TOLERANCE = std::chrono::seconds(5);
+    }
+
+    const char* trackStatusName(TrackStatus s) {
+        switch (s) {
+            case TrackStatus::DECAYED: return "decayed";
+            case TrackStatus::INVALID_ELEMENTS: return "invalid";
+            case TrackStatus::SYNTHETIC: return "synthetic";
+            default: return "ok";
+        }
+    }
+
+    bool Satellite::deriveRecord(ElementStore& store, size_t slot) {
+        ElementRecord& r = store.record(slot);
+        r = ElementRecord{};
+        std::string name(store.name(slot)), line1(store.line1(slot)), line2(store.line2(slot));
+        r.tle_hash = fnv1a(line2, fnv1a("\n", fnv1a(line1)));
         try {
-            tle_object_ = std::make_unique<libsgp4::Tle>(name_, line1, line2);
-            sgp4_object_ = std::make_unique<libsgp4::SGP4>(*tle_object_);
+            // Only the Tle parse; the libsgp4 propagator is built if and when it is needed
+            libsgp4::Tle tle(name, line1, line2);
+            r.epoch = JulianTime::fromTicks(tle.Epoch().Ticks());
+            r.norad_id = static_cast<int>(tle.NoradNumber());
 
-            // Allow override for synthetic objects
-            if (name_ == "SUN") norad_id_ = -1;
-            else if (name_ == "MOON") norad_id_ = -2;
-            else norad_id_ = static_cast<int>(tle_object_->NoradNumber());
+            r.elements.epoch_jd = r.epoch.jd();
+            r.elements.inclination = tle.Inclination(false);
+            r.elements.raan = tle.RightAscendingNode(false);
+            r.elements.eccentricity = tle.Eccentricity();
+            r.elements.arg_perigee = tle.ArgumentPerigee(false);
+            r.elements.mean_anomaly = tle.MeanAnomaly(false);
+            r.elements.mean_motion = tle.MeanMotion() * SGP4_TWOPI / SGP4_MINUTES_PER_DAY;
+            r.elements.bstar = tle.BStar();
+            r.model = initSgp4(r.elements, r.near_earth);
+            r.deriveOrbit();
+            return true;
+        } catch (...) {
+            uint64_t hash = r.tle_hash;
+            r = ElementRecord{};
+            r.tle_hash = hash;
+            return false;
+        }
+    }
 
-        } catch (...) { norad_id_ = 0; }
+    Satellite::Satellite(std::shared_ptr<const ElementStore> store, size_t slot)
+        : is_computing(false), store_(std::move(store)), slot_(static_cast<uint32_t>(slot)) {
+        rec_ = &store_->record(slot_);
+        sgp4_failed_ = rec_->norad_id == 0;
+        classify();
+    }
+
+    Satellite::Satellite(std::string_view name, std::string_view line1, std::string_view line2)
+        : is_computing(false) {
+        auto store = std::make_shared<ElementStore>(1);
+        store->setText(0, name, line1, line2);
+        sgp4_failed_ = !deriveRecord(*store, 0);
+        rec_ = &store->record(0);
+        store_ = std::move(store);
+        classify();
     }
 
     Satellite::Satellite(Satellite&& other) noexcept 
-        : name_(std::move(other.name_)),
-          norad_id_(other.norad_id_),
+        : store_(std::move(other.store_)),
+          rec_(other.rec_),
+          slot_(other.slot_),
           tle_object_(std::move(other.tle_object_)),
           sgp4_object_(std::move(other.sgp4_object_)),
-          full_track_(std::move(other.full_track_)),
-          predicted_passes_(std::move(other.predicted_passes_))
+          sgp4_failed_(other.sgp4_failed_),
+          ground_track_(std::move(other.ground_track_)),
+          schedule_(std::move(other.schedule_)),
+          pass_records_(std::move(other.pass_records_)),
+          predicted_until_(other.predicted_until_),
+          ephemeris_(std::atomic_load(&other.ephemeris_))
     {
         is_computing.store(other.is_computing.load());
+        reach_.store(other.reach_.load());
+        status_.store(other.status_.load());
     }
 
-    int Satellite::getTleEpochYear() const { return tle_object_ ? tle_object_->Epoch().Year() : 0; }
-    double Satellite::getTleEpochDay() const {
-        if (!tle_object_) return 0.0;
-        try {
-            auto dt = tle_object_->Epoch();
-            std::tm t = {}; t.tm_year = dt.Year() - 1900; t.tm_mon = dt.Month() - 1; t.tm_mday = dt.Day();
-            t.tm_hour = dt.Hour(); t.tm_min = dt.Minute(); t.tm_sec = dt.Second();
-            mktime(&t); 
-            return (t.tm_yday + 1) + (dt.Hour() + dt.Minute()/60.0 + dt.Second()/3600.0) / 24.0;
-        } catch(...) { return 0.0; }
+    void Satellite::classify() {
+        TrackStatus s = TrackStatus::NOMINAL;
+        if (rec_->norad_id < 0) s = TrackStatus::SYNTHETIC;
+        else if (sgp4_failed_ || rec_->model == Sgp4Model::INVALID) s = TrackStatus::INVALID_ELEMENTS;
+        else if (rec_->apogee_km < 80.0) s = TrackStatus::DECAYED;    // Re-entered before its epoch
+        status_.store(s);
     }
-    
-    double Satellite::getApogeeKm() const {
-        if (!tle_object_) return 0.0;
+
+    void Satellite::quarantine(TrackStatus reason) const {
+        TrackStatus expected = TrackStatus::NOMINAL;
+        status_.compare_exchange_strong(expected, reason);
+    }
+
+    void Satellite::adoptElements(const Satellite& other) {
+        if (other.getTleHash() != getTleHash()) return;
+        store_ = other.store_;
+        rec_ = other.rec_;
+        slot_ = other.slot_;
+    }
+
+    bool Satellite::ensureSgp4() const {
+        if (sgp4_object_) return true;
+        if (sgp4_failed_) return false;
         try {
-            double mm = tle_object_->MeanMotion(); 
-            double n = mm * 2.0 * PI / 86400.0; 
-            double mu = 398600.4418; 
-            double a = std::pow(mu / (n*n), 1.0/3.0); 
-            double e = tle_object_->Eccentricity();
-            return a * (1 + e) - EARTH_RADIUS_KM;
-        } catch(...) { return 0.0; }
+            if (!tle_object_) {
+                tle_object_ = std::make_unique<libsgp4::Tle>(std::string(getName()), std::string(getLine1()), std::string(getLine2()));
+            }
+            sgp4_object_ = std::make_unique<libsgp4::SGP4>(*tle_object_);
+            return true;
+        } catch (...) { sgp4_failed_ = true; return false; }
+    }
+
+    // Epoch fields straight from line 1: columns 19-20 year, 21-32 day of year
+    int Satellite::getTleEpochYear() const {
+        std::string_view l1 = getLine1();
+        if (l1.size() < 32 || rec_->norad_id == 0) return 0;
+        int yy = (l1[18] - '0') * 10 + (l1[19] - '0');
+        return yy < 57 ? 2000 + yy : 1900 + yy;
+    }
+    double Satellite::getTleEpochDay() const {
+        std::string_view l1 = getLine1();
+        if (l1.size() < 32 || rec_->norad_id == 0) return 0.0;
+        try { return std::stod(std::string(l1.substr(20, 12))); } catch (...) { return 0.0; }
     }
 
     std::pair<Vector3, Vector3> Satellite::propagate(const TimePoint& t) const {
-        if (!sgp4_object_) return {{0,0,0},{0,0,0}};
+        return propagateMinutes(JulianTime::fromTimePoint(t).minutesSince(rec_->epoch));
+    }
+    
+    std::pair<Vector3, Vector3> Satellite::propagateMinutes(double tsince) const {
+        if (isQuarantined()) return {{0,0,0},{0,0,0}};
+        auto eph = std::atomic_load(&ephemeris_);
+        if (eph) {
+            Vector3 pos, vel;
+            if (eph->evaluate(tsince, pos, vel)) return {pos, vel};
+        }
+        return propagateSgp4(tsince);
+    }
+
+    std::pair<Vector3, Vector3> Satellite::propagateSgp4(double tsince) const {
+        if (isQuarantined()) return {{0,0,0},{0,0,0}};
+        // The first failure classifies the object, so libsgp4 throws at most once per object
         try {
             std::lock_guard<std::mutex> lock(sat_mutex_);
-            std::time_t tt = Clock::to_time_t(t);
-            std::tm* gmt = std::gmtime(&tt);
-            libsgp4::DateTime dt(gmt->tm_year + 1900, gmt->tm_mon + 1, gmt->tm_mday, gmt->tm_hour, gmt->tm_min, gmt->tm_sec);
-            libsgp4::Eci eci = sgp4_object_->FindPosition(dt);
+            if (!ensureSgp4()) { quarantine(TrackStatus::INVALID_ELEMENTS); return {{0,0,0},{0,0,0}}; }
+            libsgp4::Eci eci = sgp4_object_->FindPosition(tsince);
             libsgp4::Vector pos = eci.Position(); libsgp4::Vector vel = eci.Velocity();
             return {{pos.x, pos.y, pos.z}, {vel.x, vel.y, vel.z}};
-        } catch (...) { return {{0,0,0},{0,0,0}}; }
+        } catch (const libsgp4::DecayedException&) {
+            quarantine(TrackStatus::DECAYED);
+        } catch (...) {
+            quarantine(TrackStatus::INVALID_ELEMENTS);
+        }
+        return {{0,0,0},{0,0,0}};
     }
-    
+
     Geodetic Satellite::getGeodetic(const TimePoint& t) const {
-        if (!sgp4_object_) return {0,0,0};
-        try {
-            std::lock_guard<std::mutex> lock(sat_mutex_);
-            std::time_t tt = Clock::to_time_t(t);
-            std::tm* gmt = std::gmtime(&tt);
-            libsgp4::DateTime dt(gmt->tm_year + 1900, gmt->tm_mon + 1, gmt->tm_mday, gmt->tm_hour, gmt->tm_min, gmt->tm_sec);
-            libsgp4::Eci eci = sgp4_object_->FindPosition(dt);
-            libsgp4::CoordGeodetic geo = eci.ToGeodetic();
-            return { geo.latitude * RAD2DEG, geo.longitude * RAD2DEG, geo.altitude };
-        } catch (...) { return {0,0,0}; }
+        if (isQuarantined()) return {0,0,0};
+        JulianTime jt = JulianTime::fromTimePoint(t);
+        Vector3 pos = propagateMinutes(jt.minutesSince(rec_->epoch)).first;
+        if (pos.x == 0.0 && pos.y == 0.0 && pos.z == 0.0) return {0,0,0};
+        return eciToGeodetic(pos, jt.gmst());
     }
 
     void Satellite::calculateGroundTrack(const TimePoint& now, int half_width_mins, int step_secs) {
-        std::vector<Geodetic> new_track;
-        TimePoint start = now - std::chrono::minutes(half_width_mins);
-        TimePoint end = now + std::chrono::minutes(half_width_mins);
-        TimePoint t = start;
-        // Safety reserve
-        new_track.reserve((half_width_mins * 2 * 60 / step_secs) + 5);
-        
-        while(t <= end) {
-            Geodetic g = getGeodetic(t);
+        if (isQuarantined()) return;
+        std::lock_guard<std::mutex> lock(track_mutex_);
+        ground_track_.reset(now, half_width_mins, step_secs, trackSampler());
+    }
+
+    void Satellite::advanceGroundTrack(const TimePoint& now) {
+        std::lock_guard<std::mutex> lock(track_mutex_);
+        ground_track_.advance(now, trackSampler());
+    }
+
+    GroundTrack::Sampler Satellite::trackSampler() const {
+        return [this](const TimePoint& t, Geodetic& g) {
+            g = getGeodetic(t);
             // Filter out decay errors (0,0,0)
-            if (!(std::abs(g.lat_deg) < 0.001 && std::abs(g.alt_km) < 0.001)) {
-                new_track.push_back(g);
-            }
-            t += std::chrono::seconds(step_secs);
-        }
-        std::lock_guard<std::mutex> lock(sat_mutex_);
-        full_track_ = std::move(new_track);
+            return !(std::abs(g.lat_deg) < 0.001 && std::abs(g.alt_km) < 0.001);
+        };
     }
 
     std::vector<Geodetic> Satellite::getFullTrackCopy() const {
-        std::lock_guard<std::mutex> lock(sat_mutex_);
-        return full_track_;
+        std::lock_guard<std::mutex> lock(track_mutex_);
+        return ground_track_.copy();
     }
 
     void Satellite::setPredictedPasses(const std::vector<PassEvent>& passes) {
+        std::vector<PassEvent> sorted = passes;
+        std::stable_sort(sorted.begin(), sorted.end(), [](const PassEvent& a, const PassEvent& b) { return a.time < b.time; });
         std::lock_guard<std::mutex> lock(sat_mutex_);
-        predicted_passes_ = passes;
+        schedule_.assign(std::move(sorted));
     }
 
     std::vector<Satellite::PassEvent> Satellite::getPredictedPasses() const {
         std::lock_guard<std::mutex> lock(sat_mutex_);
-        return predicted_passes_;
+        return schedule_.events();
+    }
+
+    bool Satellite::getNextEvent(const TimePoint& t, PassEvent& event) const {
+        std::lock_guard<std::mutex> lock(sat_mutex_);
+        const PassEvent* e = schedule_.next(t);
+        if (!e) return false;
+        event = *e;
+        return true;
+    }
+
+    bool Satellite::getNextAos(const TimePoint& t, TimePoint& aos) const {
+        std::lock_guard<std::mutex> lock(sat_mutex_);
+        const PassEvent* e = schedule_.nextAos(t);
+        if (!e) return false;
+        aos = e->time;
+        return true;
+    }
+
+    void Satellite::setPassRecords(const std::vector<PassRecord>& passes, const TimePoint& until) {
+        std::lock_guard<std::mutex> lock(sat_mutex_);
+        pass_records_ = passes;
+        predicted_until_ = until;
+        rebuildPassEvents();
+    }
+
+    void Satellite::extendPassRecords(const std::vector<PassRecord>& chunk, const TimePoint& until, const TimePoint& now) {
+        std::lock_guard<std::mutex> lock(sat_mutex_);
+        // 1. Drop passes that have already set
+        pass_records_.erase(std::remove_if(pass_records_.begin(), pass_records_.end(),
+                                           [&now](const PassRecord& p) { return p.has_los && p.los < now; }),
+                            pass_records_.end());
+        // 2. Join a pass split at the seam: one still up at the old horizon continues
+        // as the chunk's open first pass, a set or rise within SEAM_TOLERANCE of
+        // the seam is the same pass seen from both sides
+        auto it = chunk.begin();
+        PassRecord* back = pass_records_.empty() ? nullptr : &pass_records_.back();
+        bool open_back = back && !back->has_los;
+        bool joins = it != chunk.end() && back &&
+                     (it->has_aos ? open_back && it->aos - back->los <= SEAM_TOLERANCE
+                                  : open_back || it->aos - back->los <= SEAM_TOLERANCE);
+        if (joins) {
+            if (it->max_el > back->max_el) { back->tca = it->tca; back->tca_az = it->tca_az; back->max_el = it->max_el; }
+            back->los = it->los; back->los_az = it->los_az; back->has_los = it->has_los;
+            ++it;
+        } else if (open_back) {
+            // Set right at the seam
+            back->has_los = true;
+        }
+        // 3. Anything else open at the seam rose there: the old search ended below the horizon
+        size_t first = pass_records_.size();
+        pass_records_.insert(pass_records_.end(), it, chunk.end());
+        if (first < pass_records_.size()) pass_records_[first].has_aos = true;
+        predicted_until_ = until;
+        rebuildPassEvents();
+    }
+
+    std::vector<Satellite::PassRecord> Satellite::getPassRecords() const {
+        std::lock_guard<std::mutex> lock(sat_mutex_);
+        return pass_records_;
+    }
+
+    void Satellite::clearPredictions() {
+        std::lock_guard<std::mutex> lock(sat_mutex_);
+        pass_records_.clear();
+        predicted_until_ = TimePoint{};
+        rebuildPassEvents();
+        reach_.store(Reach::PASS_CAPABLE);
+    }
+
+    TimePoint Satellite::getPredictedUntil() const {
+        std::lock_guard<std::mutex> lock(sat_mutex_);
+        return predicted_until_;
+    }
+
+    void Satellite::rebuildPassEvents() {
+        // Records are disjoint and in time order, so the events come out sorted
+        std::vector<PassEvent> events;
+        events.reserve(pass_records_.size() * 2);
+        for (const auto& p : pass_records_) {
+            if (p.has_aos) events.push_back({p.aos, true});
+            if (p.has_los) events.push_back({p.los, false});
+        }
+        schedule_.assign(std::move(events));
+    }
+
+    std::shared_ptr<const ChebyshevEphemeris> Satellite::fitEphemeris(const TimePoint& start, double horizon_mins, double tolerance_km) const {
+        double n = getSgp4Elements().mean_motion;   // rad/min
+        if (n <= 0.0) return nullptr;
+        double t_begin = JulianTime::fromTimePoint(start).minutesSince(rec_->epoch);
+
+        ChebyshevEphemeris::Sampler sample = [this](double tsince, Vector3& pos, Vector3& vel) {
+            auto state = propagateSgp4(tsince);
+            pos = state.first; vel = state.second;
+            return !(pos.x == 0.0 && pos.y == 0.0 && pos.z == 0.0);
+        };
+        auto eph = std::make_shared<ChebyshevEphemeris>();
+        if (!eph->build(sample, t_begin, t_begin + horizon_mins, 2.0 * PI / n, tolerance_km)) return nullptr;
+        return eph;
+    }
+
+    void Satellite::setEphemeris(std::shared_ptr<const ChebyshevEphemeris> eph) {
+        std::atomic_store(&ephemeris_, std::move(eph));
+    }
+
+    std::shared_ptr<const ChebyshevEphemeris> Satellite::getEphemeris() const {
+        return std::atomic_load(&ephemeris_);
     }
 }
@@ -0,0 +1,139 @@
+#include "satellite_batch.hpp"
+#include <algorithm>
+
+namespace ve {
+    std::vector<std::vector<double>*> SatelliteBatch::lanes() {
+        return {&epoch_day_, &epoch_frac_, &mean_anomaly_, &arg_perigee_, &raan_, &inclination_, &eccentricity_, &bstar_,
+                &aodp_, &xnodp_, &cosio_, &sinio_, &eta_, &c1_, &c4_, &c5_,
+                &x1mth2_, &x3thm1_, &x7thm1_, &xlcof_, &aycof_,
+                &xmdot_, &omgdot_, &xnodot_, &xnodcf_, &t2cof_,
+                &omgcof_, &xmcof_, &delmo_, &sinmo_,
+                &d2_, &d3_, &d4_, &t3cof_, &t4cof_, &t5cof_,
+                &px_, &py_, &pz_, &vx_, &vy_, &vz_};
+    }
+
+    void SatelliteBatch::clear() {
+        sats_ = nullptr;
+        count_ = 0;
+        deep_index_.clear();
+        for (auto* lane : lanes()) {
+            lane->clear();
+        }
+        model_.clear();
+        status_.clear();
+    }
+
+    void SatelliteBatch::build(const std::vector<Satellite>& sats) {
+        clear();
+        sats_ = &sats;
+        count_ = sats.size();
+        for (auto* lane : lanes()) {
+            lane->assign(count_, 0.0);
+        }
+        model_.assign(count_, static_cast<uint8_t>(Sgp4Model::INVALID));
+        status_.assign(count_, SGP4_ERROR);
+
+        for (size_t i = 0; i < count_; ++i) {
+            if (sats[i].isQuarantined()) continue;      // Lane stays INVALID / SGP4_ERROR
+            const ElementRecord& rec = sats[i].getRecord();
+            const Sgp4NearEarth& c = rec.near_earth;
+            Sgp4Model model = rec.model;
+            model_[i] = static_cast<uint8_t>(model);
+            epoch_day_[i] = rec.epoch.day;
+            epoch_frac_[i] = rec.epoch.frac;
+            if (model == Sgp4Model::DEEP_SPACE) {
+                deep_index_.push_back(i);
+                continue;
+            }
+            if (model != Sgp4Model::NEAR_EARTH) continue;
+
+            mean_anomaly_[i] = c.mean_anomaly; arg_perigee_[i] = c.arg_perigee; raan_[i] = c.raan;
+            inclination_[i] = c.inclination; eccentricity_[i] = c.eccentricity; bstar_[i] = c.bstar;
+            aodp_[i] = c.aodp; xnodp_[i] = c.xnodp;
+            cosio_[i] = c.cosio; sinio_[i] = c.sinio; eta_[i] = c.eta; c1_[i] = c.c1; c4_[i] = c.c4; c5_[i] = c.c5;
+            x1mth2_[i] = c.x1mth2; x3thm1_[i] = c.x3thm1; x7thm1_[i] = c.x7thm1; xlcof_[i] = c.xlcof; aycof_[i] = c.aycof;
+            xmdot_[i] = c.xmdot; omgdot_[i] = c.omgdot; xnodot_[i] = c.xnodot; xnodcf_[i] = c.xnodcf; t2cof_[i] = c.t2cof;
+            omgcof_[i] = c.omgcof; xmcof_[i] = c.xmcof; delmo_[i] = c.delmo; sinmo_[i] = c.sinmo;
+            d2_[i] = c.d2; d3_[i] = c.d3; d4_[i] = c.d4; t3cof_[i] = c.t3cof; t4cof_[i] = c.t4cof; t5cof_[i] = c.t5cof;
+        }
+    }
+
+    void SatelliteBatch::propagate(const TimePoint& t) {
+        propagate(t, 0, count_);
+    }
+
+    void SatelliteBatch::propagate(const TimePoint& t, size_t begin, size_t end) {
+        end = std::min(end, count_);
+        if (begin >= end) return;
+        JulianTime jt = JulianTime::fromTimePoint(t);
+        propagateNear(jt, begin, end);
+        propagateDeep(jt, begin, end);
+    }
+
+    void SatelliteBatch::propagateNear(const JulianTime& jt, size_t begin, size_t end) {
+        // Hoist lane pointers: the uint8_t status store may otherwise alias the
+        // vector internals and force a reload of every lane per iteration.
+        const double* ed = epoch_day_.data(); const double* ef = epoch_frac_.data();
+        const double* ma = mean_anomaly_.data(); const double* ap = arg_perigee_.data(); const double* ra = raan_.data();
+        const double* in = inclination_.data(); const double* ec = eccentricity_.data(); const double* bs = bstar_.data();
+        const double* ao = aodp_.data(); const double* xn = xnodp_.data();
+        const double* co = cosio_.data(); const double* si = sinio_.data(); const double* et = eta_.data();
+        const double* k1 = c1_.data(); const double* k4 = c4_.data(); const double* k5 = c5_.data();
+        const double* x1 = x1mth2_.data(); const double* x3 = x3thm1_.data(); const double* x7 = x7thm1_.data();
+        const double* xl = xlcof_.data(); const double* ay = aycof_.data();
+        const double* md = xmdot_.data(); const double* od = omgdot_.data(); const double* nd = xnodot_.data();
+        const double* nc = xnodcf_.data(); const double* t2 = t2cof_.data();
+        const double* oc = omgcof_.data(); const double* mc = xmcof_.data(); const double* dm = delmo_.data(); const double* sm = sinmo_.data();
+        const double* d2 = d2_.data(); const double* d3 = d3_.data(); const double* d4 = d4_.data();
+        const double* t3 = t3cof_.data(); const double* t4 = t4cof_.data(); const double* t5 = t5cof_.data();
+        const uint8_t* model = model_.data();
+        double* opx = px_.data(); double* opy = py_.data(); double* opz = pz_.data();
+        double* ovx = vx_.data(); double* ovy = vy_.data(); double* ovz = vz_.data();
+        uint8_t* ost = status_.data();
+        const uint8_t near = static_cast<uint8_t>(Sgp4Model::NEAR_EARTH);
+        const double day = jt.day;
+        const double frac = jt.frac;
+
+        // Outputs never overlap the constant lanes; without ivdep the vectorizer
+        // gives up on the number of runtime alias checks it would need.
+#if defined(__GNUC__)
+#pragma GCC ivdep
+#endif
+        for (size_t i = begin; i < end; ++i) {
+            Sgp4NearEarth c;
+            c.mean_anomaly = ma[i]; c.arg_perigee = ap[i]; c.raan = ra[i];
+            c.inclination = in[i]; c.eccentricity = ec[i]; c.bstar = bs[i];
+            c.aodp = ao[i]; c.xnodp = xn[i];
+            c.cosio = co[i]; c.sinio = si[i]; c.eta = et[i]; c.c1 = k1[i]; c.c4 = k4[i]; c.c5 = k5[i];
+            c.x1mth2 = x1[i]; c.x3thm1 = x3[i]; c.x7thm1 = x7[i]; c.xlcof = xl[i]; c.aycof = ay[i];
+            c.xmdot = md[i]; c.omgdot = od[i]; c.xnodot = nd[i]; c.xnodcf = nc[i]; c.t2cof = t2[i];
+            c.omgcof = oc[i]; c.xmcof = mc[i]; c.delmo = dm[i]; c.sinmo = sm[i];
+            c.d2 = d2[i]; c.d3 = d3[i]; c.d4 = d4[i]; c.t3cof = t3[i]; c.t4cof = t4[i]; c.t5cof = t5[i];
+
+            const double tsince = ((day - ed[i]) + (frac - ef[i])) * SGP4_MINUTES_PER_DAY;
+            double x, y, z, xd, yd, zd;
+            uint8_t s = propagateNearEarth(c, tsince, x, y, z, xd, yd, zd);
+            // Lanes that are not near-earth carry zeroed constants; their result is
+            // discarded here and filled in by the deep-space pass where applicable.
+            const bool is_near = (model[i] == near);
+            opx[i] = is_near ? x : 0.0; opy[i] = is_near ? y : 0.0; opz[i] = is_near ? z : 0.0;
+            ovx[i] = is_near ? xd : 0.0; ovy[i] = is_near ? yd : 0.0; ovz[i] = is_near ? zd : 0.0;
+            ost[i] = is_near ? s : static_cast<uint8_t>(SGP4_ERROR);
+        }
+    }
+
+    void SatelliteBatch::propagateDeep(const JulianTime& jt, size_t begin, size_t end) {
+        if (!sats_) return;
+        auto it = std::lower_bound(deep_index_.begin(), deep_index_.end(), begin);
+        for (; it != deep_index_.end() && *it < end; ++it) {
+            size_t i = *it;
+            if ((*sats_)[i].isQuarantined()) { status_[i] = SGP4_ERROR; continue; }
+            const double tsince = jt.minutesSince((*sats_)[i].getEpoch());
+            auto [pos, vel] = (*sats_)[i].propagateMinutes(tsince);
+            px_[i] = pos.x; py_[i] = pos.y; pz_[i] = pos.z;
+            vx_[i] = vel.x; vy_[i] = vel.y; vz_[i] = vel.z;
+            bool valid = (pos.x != 0.0 || pos.y != 0.0 || pos.z != 0.0);
+            status_[i] = valid ? SGP4_OK : SGP4_ERROR;
+        }
+    }
+}
@@ -0,0 +1,116 @@
+#include "sgp4_kernel.hpp"
+
+namespace ve {
+    Sgp4Model initSgp4(const Sgp4Elements& el, Sgp4NearEarth& c) {
+        c = {};
+        if (!(el.mean_motion > 0.0)) return Sgp4Model::INVALID;
+        if (el.eccentricity < 0.0 || el.eccentricity > 0.999) return Sgp4Model::INVALID;
+        if (el.inclination < 0.0 || el.inclination > SGP4_TWOPI / 2.0) return Sgp4Model::INVALID;
+
+        const double xke = 60.0 / std::sqrt(SGP4_XKMPER * SGP4_XKMPER * SGP4_XKMPER / SGP4_MU);
+        const double qoms2t = std::pow((120.0 - 78.0) / SGP4_XKMPER, 4.0);
+        const double s = 1.0 + 78.0 / SGP4_XKMPER;
+
+        // 1. Recover original mean motion and semi-major axis
+        const double cosio = std::cos(el.inclination);
+        const double sinio = std::sin(el.inclination);
+        const double theta2 = cosio * cosio;
+        const double x3thm1 = 3.0 * theta2 - 1.0;
+        const double eosq = el.eccentricity * el.eccentricity;
+        const double betao2 = 1.0 - eosq;
+        const double betao = std::sqrt(betao2);
+        const double a1 = std::pow(xke / el.mean_motion, 2.0 / 3.0);
+        const double temp = 1.5 * SGP4_CK2 * x3thm1 / (betao * betao2);
+        const double del1 = temp / (a1 * a1);
+        const double a0 = a1 * (1.0 - del1 * (1.0 / 3.0 + del1 * (1.0 + del1 * 134.0 / 81.0)));
+        const double del0 = temp / (a0 * a0);
+        const double xnodp = el.mean_motion / (1.0 + del0);
+        const double aodp = a0 / (1.0 - del0);
+        const double perigee = (aodp * (1.0 - el.eccentricity) - 1.0) * SGP4_XKMPER;
+        const double period = SGP4_TWOPI / xnodp;
+
+        if (period >= 225.0) return Sgp4Model::DEEP_SPACE;
+        const bool simple_model = (perigee < 220.0);
+
+        // 2. Drag coefficients (perigee dependent atmosphere)
+        double s4 = s;
+        double qoms24 = qoms2t;
+        if (perigee < 156.0) {
+            s4 = perigee - 78.0;
+            if (perigee < 98.0) s4 = 20.0;
+            qoms24 = std::pow((120.0 - s4) / SGP4_XKMPER, 4.0);
+            s4 = s4 / SGP4_XKMPER + 1.0;
+        }
+        const double pinvsq = 1.0 / (aodp * aodp * betao2 * betao2);
+        const double tsi = 1.0 / (aodp - s4);
+        const double eta = aodp * el.eccentricity * tsi;
+        const double etasq = eta * eta;
+        const double eeta = el.eccentricity * eta;
+        const double psisq = std::fabs(1.0 - etasq);
+        const double coef = qoms24 * std::pow(tsi, 4.0);
+        const double coef1 = coef / std::pow(psisq, 3.5);
+        const double c2 = coef1 * xnodp * (aodp * (1.0 + 1.5 * etasq + eeta * (4.0 + etasq))
+                        + 0.75 * SGP4_CK2 * tsi / psisq * x3thm1 * (8.0 + 3.0 * etasq * (8.0 + etasq)));
+        const double c1 = el.bstar * c2;
+        const double a3ovk2 = -SGP4_XJ3 / SGP4_CK2;
+        const double x1mth2 = 1.0 - theta2;
+        const double c4 = 2.0 * xnodp * coef1 * aodp * betao2 * (eta * (2.0 + 0.5 * etasq) + el.eccentricity * (0.5 + 2.0 * etasq)
+                        - 2.0 * SGP4_CK2 * tsi / (aodp * psisq) * (-3.0 * x3thm1 * (1.0 - 2.0 * eeta + etasq * (1.5 - 0.5 * eeta))
+                        + 0.75 * x1mth2 * (2.0 * etasq - eeta * (1.0 + etasq)) * std::cos(2.0 * el.arg_perigee)));
+
+        // 3. Secular rates
+        const double theta4 = theta2 * theta2;
+        const double temp1 = 3.0 * SGP4_CK2 * pinvsq * xnodp;
+        const double temp2 = temp1 * SGP4_CK2 * pinvsq;
+        const double temp3 = 1.25 * SGP4_CK4 * pinvsq * pinvsq * xnodp;
+        const double x1m5th = 1.0 - 5.0 * theta2;
+        const double xhdot1 = -temp1 * cosio;
+
+        c.epoch_jd = el.epoch_jd;
+        c.mean_anomaly = el.mean_anomaly;
+        c.arg_perigee = el.arg_perigee;
+        c.raan = el.raan;
+        c.inclination = el.inclination;
+        c.eccentricity = el.eccentricity;
+        c.bstar = el.bstar;
+        c.aodp = aodp;
+        c.xnodp = xnodp;
+        c.cosio = cosio;
+        c.sinio = sinio;
+        c.eta = eta;
+        c.c1 = c1;
+        c.c4 = c4;
+        c.x1mth2 = x1mth2;
+        c.x3thm1 = x3thm1;
+        c.x7thm1 = 7.0 * theta2 - 1.0;
+        c.xmdot = xnodp + 0.5 * temp1 * betao * x3thm1 + 0.0625 * temp2 * betao * (13.0 - 78.0 * theta2 + 137.0 * theta4);
+        c.omgdot = -0.5 * temp1 * x1m5th + 0.0625 * temp2 * (7.0 - 114.0 * theta2 + 395.0 * theta4) + temp3 * (3.0 - 36.0 * theta2 + 49.0 * theta4);
+        c.xnodot = xhdot1 + (0.5 * temp2 * (4.0 - 19.0 * theta2) + 2.0 * temp3 * (3.0 - 7.0 * theta2)) * cosio;
+        c.xnodcf = 3.5 * betao2 * xhdot1 * c1;
+        c.t2cof = 1.5 * c1;
+        const double xlcof_den = (std::fabs(cosio + 1.0) > 1.5e-12) ? (1.0 + cosio) : 1.5e-12;
+        c.xlcof = 0.125 * a3ovk2 * sinio * (3.0 + 5.0 * cosio) / xlcof_den;
+        c.aycof = 0.25 * a3ovk2 * sinio;
+
+        // 4. Near-earth drag terms (zero for the simple model)
+        if (!simple_model) {
+            double c3 = 0.0;
+            if (el.eccentricity > 1.0e-4) c3 = coef * tsi * a3ovk2 * xnodp * sinio / el.eccentricity;
+            c.c5 = 2.0 * coef1 * aodp * betao2 * (1.0 + 2.75 * (etasq + eeta) + eeta * etasq);
+            c.omgcof = el.bstar * c3 * std::cos(el.arg_perigee);
+            if (el.eccentricity > 1.0e-4) c.xmcof = -2.0 / 3.0 * coef * el.bstar / eeta;
+            c.delmo = std::pow(1.0 + eta * std::cos(el.mean_anomaly), 3.0);
+            c.sinmo = std::sin(el.mean_anomaly);
+
+            const double c1sq = c1 * c1;
+            c.d2 = 4.0 * aodp * tsi * c1sq;
+            const double tmp = c.d2 * tsi * c1 / 3.0;
+            c.d3 = (17.0 * aodp + s4) * tmp;
+            c.d4 = 0.5 * tmp * aodp * tsi * (221.0 * aodp + 31.0 * s4) * c1;
+            c.t3cof = c.d2 + 2.0 * c1sq;
+            c.t4cof = 0.25 * (3.0 * c.d3 + c1 * (12.0 * c.d2 + 10.0 * c1sq));
+            c.t5cof = 0.2 * (3.0 * c.d4 + 12.0 * c1 * c.d3 + 6.0 * c.d2 * c.d2 + 15.0 * c1sq * (2.0 * c.d2 + c1sq));
+        }
+        return Sgp4Model::NEAR_EARTH;
+    }
+}
@@ -38,10 +38,6 @@ namespace ve {
         if(server_thread_.joinable()) server_thread_.join();
     }
 
-    void TextServer::updateData(const std::string& text_view) {
-        std::lock_guard<std::mutex> lock(data_mutex_);
-        current_text_view_ = text_view;
-    }
 
     void TextServer::serverLoop() {
         while (running_) {
@@ -63,17 +59,15 @@ namespace ve {
                 int r = read(new_socket, buffer, 4096); 
 
                 // 3. PREPARE RESPONSE IMMEDIATELY
-                std::string local_view;
-                {
-                    std::lock_guard<std::mutex> lock(data_mutex_);
-                    local_view = current_text_view_;
-                }
+                auto frame = frames_ ? frames_->latest() : nullptr;
                 
                 std::string content = 
                     "<!DOCTYPE html><html><head><meta http-equiv='refresh' content='1'>"
                     "<title>Visible Ephemeris Terminal</title>"
                     "<style>body { background: #000; color: #0f0; font-family: monospace; font-size: 14px; white-space: pre; }</style>"
-                    "</head><body>" + local_view + "</body></html>";
+                    "</head><body>";
+                content += frame ? frame->text : std::string("Waiting for data...");
+                content += "</body></html>";
                 
                 // 4. SEND WITH CONTENT-LENGTH
                 std::string response = "HTTP/1.0 200 OK\r\n"
@@ -0,0 +1,230 @@
+#include "tick_pipeline.hpp"
+#include "visibility.hpp"
+#include <algorithm>
+#include <limits>
+
+namespace ve {
+    void TickPipeline::run(std::vector<Satellite>& sats, const std::vector<CelestialBody>& bodies, SatelliteBatch& batch,
+                           const Observer& observer, const AppConfig& cfg, const TimePoint& now, int selected_norad_id, Output& out) {
+        const size_t n = sats.size();
+        apogee_.resize(n);
+        live_.resize(n);
+        look_.resize(n);
+        range_rate_.resize(n);
+        vis_.resize(n);
+        flare_.resize(n);
+
+        const size_t limit = (cfg.max_sats > 0) ? static_cast<size_t>(cfg.max_sats) : 5000;
+        const SortKey key = parseSortKey(cfg.sort_by);
+
+        // About four shards per thread so a slow shard (deep-space fallbacks) can be stolen around
+        size_t threads = scheduler_.size() + 1;
+        size_t shard_size = std::max(MIN_SHARD, (n + 4 * threads - 1) / (4 * threads));
+        size_t shard_count = (n + shard_size - 1) / shard_size;
+        if (shards_.size() < shard_count) shards_.resize(shard_count);
+
+        // Per-tick geometry does not depend on the propagated states, so it is shared up front
+        FrameContext frame(now, observer, &batch);
+
+        scheduler_.parallel_for(n, shard_size, [&](size_t begin, size_t end) {
+            Shard& shard = shards_[begin / shard_size];
+            shard.top.reset(limit);
+            shard.stats = Stats{};
+            shard.has_selected = false;
+            propagateStage(sats, batch, now, begin, end);
+            topocentricStage(observer, frame, begin, end);
+            filterStage(sats, frame, cfg, key, selected_norad_id, shard, begin, end);
+        });
+
+        // 1. Sun/Moon claim their slots first; the shards' best fill the rest
+        out.stats = Stats{};
+        out.has_selected = false;
+        selected_.clear();
+        body_look_.resize(bodies.size());
+        body_range_rate_.resize(bodies.size());
+        for (size_t b = 0; b < bodies.size(); ++b) {
+            const Vector3& pos = bodies[b].kind() == CelestialBody::Kind::SUN ? frame.sun : frame.moon;
+            const auto& look = body_look_[b] = observer.calculateLookAngle(pos, frame);
+            body_range_rate_[b] = observer.calculateRangeRate(pos, Vector3{0.0, 0.0, 0.0}, frame);
+            if (bodies[b].getNoradId() == selected_norad_id) {
+                out.has_selected = true;
+                out.selected_look = look;
+            }
+            if (look.elevation < cfg.min_el) continue;
+            double sort_key = (key == SortKey::RANGE) ? look.range : -look.elevation;
+            selected_.push_back({sort_key, n + b});
+        }
+        for (size_t s = 0; s < shard_count; ++s) {
+            Shard& shard = shards_[s];
+            out.stats.rejected_apo += shard.stats.rejected_apo;
+            out.stats.rejected_el += shard.stats.rejected_el;
+            out.stats.rejected_vis += shard.stats.rejected_vis;
+            out.stats.quarantined += shard.stats.quarantined;
+            if (shard.has_selected && !out.has_selected) {
+                out.has_selected = true;
+                out.selected_look = shard.selected_look;
+            }
+        }
+        TopK top(limit > selected_.size() ? limit - selected_.size() : 0);
+        for (size_t s = 0; s < shard_count; ++s) {
+            for (const auto& c : shards_[s].top.items()) top.offer(c);
+        }
+        auto best = top.takeSorted();
+        selected_.insert(selected_.end(), best.begin(), best.end());
+        std::sort(selected_.begin(), selected_.end(), sortsBefore);
+
+        // 2. Rows only for what will be shown
+        out.rows.resize(selected_.size());
+        scheduler_.parallel_for(selected_.size(), 16, [&](size_t begin, size_t end) {
+            for (size_t r = begin; r < end; ++r) {
+                size_t i = selected_[r].index;
+                out.rows[r] = (i < n) ? buildRow(sats[i], frame, i) : buildBodyRow(bodies[i - n], frame, i - n);
+            }
+        });
+    }
+
+    void TickPipeline::propagateStage(std::vector<Satellite>& sats, SatelliteBatch& batch, const TimePoint& now, size_t begin, size_t end) {
+        batch.propagate(now, begin, end);
+        for (size_t i = begin; i < end; ++i) {
+            apogee_[i] = sats[i].getApogeeKm();
+            live_[i] = 0;
+            if (sats[i].isQuarantined()) continue;
+            // A failing lane is classified once and leaves every propagation path
+            if (!batch.ok(i)) {
+                sats[i].quarantine(batch.status(i) == SGP4_DECAYED ? TrackStatus::DECAYED : TrackStatus::INVALID_ELEMENTS);
+                continue;
+            }
+            // Slide the trail with physics time (usually a no-op or one new sample)
+            sats[i].advanceGroundTrack(now);
+            live_[i] = 1;
+        }
+    }
+
+    void TickPipeline::topocentricStage(const Observer& observer, const FrameContext& frame, size_t begin, size_t end) {
+        for (size_t i = begin; i < end; ++i) {
+            if (!live_[i]) continue;
+            Vector3 pos = frame.states->position(i);
+            look_[i] = observer.calculateLookAngle(pos, frame);
+            range_rate_[i] = observer.calculateRangeRate(pos, frame.states->velocity(i), frame);
+        }
+    }
+
+    void TickPipeline::filterStage(const std::vector<Satellite>& sats, const FrameContext& frame, const AppConfig& cfg, SortKey key,
+                                   int selected_norad_id, Shard& shard, size_t begin, size_t end) {
+        // 1. Illumination for the whole slice in one pass; flares too when they rank
+        const SatelliteBatch& st = *frame.states;
+        size_t count = end - begin;
+        VisibilityCalculator::calculateStates(st.px() + begin, st.py() + begin, st.pz() + begin, count,
+                                              frame.obs_pos, frame.sun, vis_.data() + begin);
+        if (key == SortKey::FLARE) {
+            VisibilityCalculator::checkFlares(st.px() + begin, st.py() + begin, st.pz() + begin, apogee_.data() + begin,
+                                              vis_.data() + begin, count, frame.obs_pos, frame.sun, flare_.data() + begin);
+        } else {
+            std::fill(flare_.begin() + begin, flare_.begin() + end, int8_t{-1});
+        }
+
+        // 2. Filters and ranking
+        for (size_t i = begin; i < end; ++i) {
+            if (!live_[i]) {
+                if (sats[i].isQuarantined()) shard.stats.quarantined++;
+                continue;
+            }
+            const auto& look = look_[i];
+
+            // Rotator target is reported regardless of display filters
+            if (sats[i].getNoradId() == selected_norad_id && !shard.has_selected) {
+                shard.has_selected = true;
+                shard.selected_look = look;
+            }
+
+            // If visible_only is TRUE, we skip if NOT visible.
+            if (cfg.visible_only && vis_[i] != VisibilityCalculator::State::VISIBLE) {
+                shard.stats.rejected_vis++;
+                continue;
+            }
+            if (look.elevation < cfg.min_el) {
+                shard.stats.rejected_el++;
+                continue;
+            }
+            if (cfg.max_apo > 0 && apogee_[i] > cfg.max_apo) {
+                shard.stats.rejected_apo++;
+                continue;
+            }
+
+            shard.top.offer({sortKey(sats[i], key, i, frame), i});
+        }
+    }
+
+    double TickPipeline::sortKey(const Satellite& sat, SortKey key, size_t i, const FrameContext& frame) {
+        const auto& look = look_[i];
+        switch (key) {
+            case SortKey::RANGE:
+                return look.range;
+            case SortKey::NEXT_AOS: {
+                // Up now ranks ahead of any future rise, highest first
+                if (look.elevation >= 0.0) return -look.elevation;
+                TimePoint aos;
+                if (!sat.getNextAos(frame.time, aos)) return std::numeric_limits<double>::infinity();
+                return std::chrono::duration<double>(aos - frame.time).count();
+            }
+            case SortKey::FLARE:
+                // Filled for the slice by checkFlares in filterStage
+                return -(flare_[i] * 1000.0 + look.elevation);
+            default:
+                return -look.elevation;
+        }
+    }
+
+    DisplayRow TickPipeline::buildRow(const Satellite& sat, const FrameContext& frame, size_t i) {
+        Vector3 pos = frame.states->position(i);
+
+        // Flare Calculation (Only relevant if visible)
+        int flare_status = flare_[i];
+        if (flare_status < 0) {
+            flare_status = 0;
+            if (vis_[i] == VisibilityCalculator::State::VISIBLE) {
+                flare_status = VisibilityCalculator::checkFlare(pos, frame, apogee_[i]);
+            }
+        }
+        auto geo = eciToGeodetic(pos, frame.gmst);
+        const auto& look = look_[i];
+        DisplayRow row;
+        row.name = std::string(sat.getName());
+        row.az = look.azimuth; row.el = look.elevation; row.range = look.range; row.range_rate = range_rate_[i];
+        row.lat = geo.lat_deg; row.lon = geo.lon_deg;
+        row.apogee = apogee_[i];
+        row.state = vis_[i];
+        row.norad_id = sat.getNoradId();
+        // Cursor lookup; the countdown text is left to the renderers
+        Satellite::PassEvent next;
+        row.pending = !sat.hasPredictions();
+        row.has_next_event = sat.getNextEvent(frame.time, next);
+        row.next_is_aos = row.has_next_event && next.is_aos;
+        row.next_event_time = row.has_next_event ? next.time : TimePoint{};
+        row.flare_status = flare_status;
+        return row;
+    }
+
+    DisplayRow TickPipeline::buildBodyRow(const CelestialBody& body, const FrameContext& frame, size_t b) {
+        const bool sun = body.kind() == CelestialBody::Kind::SUN;
+        const Vector3& pos = sun ? frame.sun : frame.moon;
+        auto geo = eciToGeodetic(pos, frame.gmst);
+        const auto& look = body_look_[b];
+        DisplayRow row;
+        row.name = body.getName();
+        row.az = look.azimuth; row.el = look.elevation; row.range = look.range; row.range_rate = body_range_rate_[b];
+        row.lat = geo.lat_deg; row.lon = geo.lon_deg;
+        row.apogee = 0.0;
+        // The Moon is worth a look once the sky is dark
+        row.state = (!sun && frame.sun_el < (-6.0 * DEG2RAD)) ? VisibilityCalculator::State::VISIBLE : VisibilityCalculator::State::DAYLIGHT;
+        row.norad_id = body.getNoradId();
+        // Each body is in the selection once, so only this task moves its cursor
+        const CelestialBody::PassEvent* next = body.nextEvent(frame.time);
+        row.pending = body.getPredictedUntil() == TimePoint{};
+        row.has_next_event = next != nullptr;
+        row.next_is_aos = next && next->is_aos;
+        row.next_event_time = next ? next->time : TimePoint{};
+        row.flare_status = 0;
+        return row;
+    }
+}
@@ -0,0 +1,165 @@
+#include "tle_catalog.hpp"
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <type_traits>
+
+namespace ve {
+    // Records are 8-byte multiples, so the array stays aligned when mapped;
+    // record_size guards against a struct layout change without a version bump
+    struct TleCatalog::Header {
+        char magic[4];
+        uint32_t version;
+        uint32_t record_size;
+        uint32_t reserved;
+        int64_t source_size;
+        int64_t source_mtime;
+        uint64_t record_count;
+        uint64_t text_size;
+    };
+    struct TleCatalog::Record {
+        int32_t norad_id;
+        uint32_t model;
+        uint64_t tle_hash;
+        double epoch_day, epoch_frac;
+        Sgp4Elements elements;
+        Sgp4NearEarth near_earth;
+        uint64_t text_offset;       // name, line 1, line 2 back to back
+        uint32_t name_len, line1_len, line2_len;
+        uint32_t reserved;
+    };
+    static_assert(std::is_trivially_copyable<Sgp4NearEarth>::value, "catalog stores the constants verbatim");
+
+    namespace {
+        constexpr char MAGIC[4] = {'V', 'E', 'T', 'C'};
+        constexpr uint32_t VERSION = 1;
+
+        bool sourceStamp(const std::string& path, int64_t& size, int64_t& mtime) {
+            std::error_code ec;
+            auto sz = std::filesystem::file_size(path, ec);
+            if (ec) return false;
+            auto mt = std::filesystem::last_write_time(path, ec);
+            if (ec) return false;
+            size = static_cast<int64_t>(sz);
+            mtime = static_cast<int64_t>(mt.time_since_epoch().count());
+            return true;
+        }
+    }
+
+    std::string TleCatalog::pathFor(const std::string& text_path) {
+        std::filesystem::path p(text_path);
+        return p.replace_extension(".catalog").string();
+    }
+
+    bool TleCatalog::open(const std::string& text_path) {
+        close();
+        int64_t size = 0, mtime = 0;
+        if (!sourceStamp(text_path, size, mtime)) return false;
+        if (!file_.open(pathFor(text_path)) || file_.size() < sizeof(Header)) { close(); return false; }
+        const uint8_t* base = file_.data();
+
+        // 1. Format, and compiled from the text file as it is now
+        const Header* h = reinterpret_cast<const Header*>(base);
+        bool ok = std::memcmp(h->magic, MAGIC, sizeof(MAGIC)) == 0 && h->version == VERSION &&
+                  h->record_size == sizeof(Record) && h->source_size == size && h->source_mtime == mtime;
+
+        // 2. Array sizes must add up to the file size exactly. The counts are
+        // untrusted: bound each by the file first so the product and sum cannot wrap.
+        size_t body = file_.size() - sizeof(Header);
+        ok = ok && h->record_count <= body / sizeof(Record) && h->text_size <= body;
+        ok = ok && body == h->record_count * sizeof(Record) + h->text_size;
+        if (!ok) { close(); return false; }
+        records_ = reinterpret_cast<const Record*>(base + sizeof(Header));
+        count_ = h->record_count;
+        text_ = reinterpret_cast<const char*>(records_ + count_);
+        text_size_ = h->text_size;
+
+        // 3. Every record in bounds
+        for (size_t i = 0; i < count_ && ok; ++i) {
+            const Record& r = records_[i];
+            uint64_t len = uint64_t(r.name_len) + r.line1_len + r.line2_len;
+            ok = r.model <= static_cast<uint32_t>(Sgp4Model::INVALID) &&
+                 r.text_offset <= text_size_ && len <= text_size_ - r.text_offset;
+        }
+        if (!ok) { close(); return false; }
+        return true;
+    }
+
+    void TleCatalog::close() {
+        file_.close();
+        records_ = nullptr;
+        text_ = nullptr;
+        count_ = text_size_ = 0;
+    }
+
+    std::shared_ptr<ElementStore> TleCatalog::load() const {
+        auto store = std::make_shared<ElementStore>(count_);
+        for (size_t i = 0; i < count_; ++i) {
+            const Record& r = records_[i];
+            const char* s = text_ + r.text_offset;
+            store->setText(i, std::string_view(s, r.name_len),
+                           std::string_view(s + r.name_len, r.line1_len),
+                           std::string_view(s + r.name_len + r.line1_len, r.line2_len));
+            ElementRecord& e = store->record(i);
+            e.norad_id = r.norad_id;
+            e.model = static_cast<Sgp4Model>(r.model);
+            e.tle_hash = r.tle_hash;
+            e.epoch = JulianTime{r.epoch_day, r.epoch_frac};
+            e.elements = r.elements;
+            e.near_earth = r.near_earth;
+            e.deriveOrbit();
+        }
+        return store;
+    }
+
+    bool TleCatalog::save(const std::string& text_path, const ElementStore& store) {
+        Header h{};
+        std::memcpy(h.magic, MAGIC, sizeof(MAGIC));
+        h.version = VERSION;
+        h.record_size = sizeof(Record);
+        if (!sourceStamp(text_path, h.source_size, h.source_mtime)) return false;
+
+        // 1. Flatten the derived state; lines go to the text blob
+        std::vector<Record> records;
+        std::string text;
+        records.reserve(store.size());
+        for (size_t i = 0; i < store.size(); ++i) {
+            const ElementRecord& e = store.record(i);
+            if (e.norad_id == 0) continue;      // Element set failed to parse
+            std::string_view name = store.name(i), line1 = store.line1(i), line2 = store.line2(i);
+            Record r{};
+            r.norad_id = e.norad_id;
+            r.model = static_cast<uint32_t>(e.model);
+            r.tle_hash = e.tle_hash;
+            r.epoch_day = e.epoch.day;
+            r.epoch_frac = e.epoch.frac;
+            r.elements = e.elements;
+            r.near_earth = e.near_earth;
+            r.text_offset = text.size();
+            r.name_len = static_cast<uint32_t>(name.size());
+            r.line1_len = static_cast<uint32_t>(line1.size());
+            r.line2_len = static_cast<uint32_t>(line2.size());
+            text += name;
+            text += line1;
+            text += line2;
+            records.push_back(r);
+        }
+        h.record_count = records.size();
+        h.text_size = text.size();
+
+        // 2. Write beside the old file, then swap it in
+        std::string path = pathFor(text_path);
+        std::string tmp = path + ".tmp";
+        FILE* f = std::fopen(tmp.c_str(), "wb");
+        if (!f) return false;
+        bool ok = std::fwrite(&h, sizeof(h), 1, f) == 1;
+        ok = ok && std::fwrite(records.data(), sizeof(Record), records.size(), f) == records.size();
+        ok = ok && std::fwrite(text.data(), 1, text.size(), f) == text.size();
+        ok = (std::fclose(f) == 0) && ok;
+        if (!ok || std::rename(tmp.c_str(), path.c_str()) != 0) {
+            std::remove(tmp.c_str());
+            return false;
+        }
+        return true;
+    }
+}
@@ -0,0 +1,188 @@
+#include "tle_fetcher.hpp"
+#include "logger.hpp"
+#include <iostream>
+#include <fstream>
+#include <cstdio>
+#include <cctype>
+#include <algorithm>
+#include <filesystem>
+
+namespace ve {
+    namespace {
+        struct Meta {
+            std::string etag;
+            std::string last_modified;
+            std::time_t checked = 0;
+        };
+
+        std::string metaPath(const std::string& path) { return path + ".meta"; }
+
+        std::string trim(const std::string& s) {
+            size_t first = s.find_first_not_of(" \t\r\n");
+            if (first == std::string::npos) return "";
+            size_t last = s.find_last_not_of(" \t\r\n");
+            return s.substr(first, last - first + 1);
+        }
+
+        Meta readMeta(const std::string& path) {
+            Meta m;
+            std::ifstream file(metaPath(path));
+            std::string line;
+            while (std::getline(file, line)) {
+                size_t delim = line.find(": ");
+                if (delim == std::string::npos) continue;
+                std::string key = line.substr(0, delim), val = trim(line.substr(delim + 2));
+                if (key == "etag") m.etag = val;
+                else if (key == "last_modified") m.last_modified = val;
+                else if (key == "checked") { try { m.checked = static_cast<std::time_t>(std::stoll(val)); } catch (...) {} }
+            }
+            return m;
+        }
+
+        void writeMeta(const std::string& path, const Meta& m) {
+            std::ofstream file(metaPath(path));
+            file << "etag: " << m.etag << "\n";
+            file << "last_modified: " << m.last_modified << "\n";
+            file << "checked: " << static_cast<long long>(m.checked) << "\n";
+        }
+
+        bool startsWithNoCase(const std::string& s, const char* prefix) {
+            size_t n = std::char_traits<char>::length(prefix);
+            if (s.size() < n) return false;
+            for (size_t i = 0; i < n; ++i) {
+                if (std::tolower(static_cast<unsigned char>(s[i])) != std::tolower(static_cast<unsigned char>(prefix[i]))) return false;
+            }
+            return true;
+        }
+    }
+
+    struct TleFetcher::Transfer {
+        const Job* job = nullptr;
+        CURL* easy = nullptr;
+        curl_slist* headers = nullptr;
+        std::string body;
+        Meta meta;              // Validators of the copy on disk
+        std::string response_etag, response_modified;
+        Result result = Result::FAILED;
+
+        static size_t onBody(void* data, size_t size, size_t nmemb, void* userp) {
+            static_cast<Transfer*>(userp)->body.append(static_cast<char*>(data), size * nmemb);
+            return size * nmemb;
+        }
+        static size_t onHeader(char* data, size_t size, size_t nitems, void* userp) {
+            auto* t = static_cast<Transfer*>(userp);
+            std::string line(data, size * nitems);
+            // A redirect starts a new response; only the final one's validators count
+            if (startsWithNoCase(line, "HTTP/")) { t->response_etag.clear(); t->response_modified.clear(); }
+            else if (startsWithNoCase(line, "ETag:")) t->response_etag = trim(line.substr(5));
+            else if (startsWithNoCase(line, "Last-Modified:")) t->response_modified = trim(line.substr(14));
+            return size * nitems;
+        }
+    };
+
+    TleFetcher::TleFetcher() {
+        curl_global_init(CURL_GLOBAL_DEFAULT);
+        multi_ = curl_multi_init();
+        if (multi_) {
+            curl_multi_setopt(multi_, CURLMOPT_MAX_HOST_CONNECTIONS, MAX_PER_HOST);
+            curl_multi_setopt(multi_, CURLMOPT_PIPELINING, static_cast<long>(CURLPIPE_MULTIPLEX));
+        }
+    }
+
+    TleFetcher::~TleFetcher() {
+        if (multi_) curl_multi_cleanup(multi_);
+        curl_global_cleanup();
+    }
+
+    std::time_t TleFetcher::lastChecked(const std::string& path) {
+        return std::filesystem::exists(path) ? readMeta(path).checked : 0;
+    }
+
+    std::vector<TleFetcher::Result> TleFetcher::fetch(const std::vector<Job>& jobs) {
+        if (!multi_) return std::vector<Result>(jobs.size(), Result::FAILED);
+        std::vector<Transfer> transfers(jobs.size());
+
+        // 1. One easy handle per job, conditional when a copy is already on disk
+        for (size_t i = 0; i < jobs.size(); ++i) {
+            Transfer& t = transfers[i];
+            t.job = &jobs[i];
+            if (std::filesystem::exists(jobs[i].path)) t.meta = readMeta(jobs[i].path);
+            t.easy = curl_easy_init();
+            if (!t.easy) continue;
+            if (!t.meta.etag.empty()) t.headers = curl_slist_append(t.headers, ("If-None-Match: " + t.meta.etag).c_str());
+            if (!t.meta.last_modified.empty()) t.headers = curl_slist_append(t.headers, ("If-Modified-Since: " + t.meta.last_modified).c_str());
+            curl_easy_setopt(t.easy, CURLOPT_URL, jobs[i].url.c_str());
+            curl_easy_setopt(t.easy, CURLOPT_WRITEFUNCTION, &Transfer::onBody);
+            curl_easy_setopt(t.easy, CURLOPT_WRITEDATA, &t);
+            curl_easy_setopt(t.easy, CURLOPT_HEADERFUNCTION, &Transfer::onHeader);
+            curl_easy_setopt(t.easy, CURLOPT_HEADERDATA, &t);
+            curl_easy_setopt(t.easy, CURLOPT_HTTPHEADER, t.headers);
+            curl_easy_setopt(t.easy, CURLOPT_PRIVATE, &t);
+            curl_easy_setopt(t.easy, CURLOPT_USERAGENT, "VisibleEphemeris/12.112");
+            curl_easy_setopt(t.easy, CURLOPT_ACCEPT_ENCODING, "");     // gzip where offered
+            curl_easy_setopt(t.easy, CURLOPT_FOLLOWLOCATION, 1L);
+            curl_easy_setopt(t.easy, CURLOPT_FAILONERROR, 1L);
+            curl_easy_setopt(t.easy, CURLOPT_CONNECTTIMEOUT, 10L);
+            curl_easy_setopt(t.easy, CURLOPT_TIMEOUT, TIMEOUT_SECS);
+            curl_multi_add_handle(multi_, t.easy);
+        }
+
+        // 2. Drive all transfers together
+        int still_running = 0;
+        do {
+            CURLMcode mc = curl_multi_perform(multi_, &still_running);
+            if (mc != CURLM_OK) {
+                Logger::log("Fetch aborted: " + std::string(curl_multi_strerror(mc)));
+                break;
+            }
+            if (still_running > 0) curl_multi_poll(multi_, nullptr, 0, 1000, nullptr);
+        } while (still_running > 0);
+
+        // 3. Results: replace the file on 200, refresh the confirmation on 304
+        int pending = 0;
+        while (CURLMsg* msg = curl_multi_info_read(multi_, &pending)) {
+            if (msg->msg != CURLMSG_DONE) continue;
+            Transfer* t = nullptr;
+            curl_easy_getinfo(msg->easy_handle, CURLINFO_PRIVATE, reinterpret_cast<char**>(&t));
+            long code = 0;
+            curl_easy_getinfo(msg->easy_handle, CURLINFO_RESPONSE_CODE, &code);
+            const std::string& path = t->job->path;
+            if (msg->data.result != CURLE_OK) {
+                std::cout << "[NET] " << t->job->url << " FAILED (" << curl_easy_strerror(msg->data.result) << ")" << std::endl;
+                Logger::log("Download failed: " + std::string(curl_easy_strerror(msg->data.result)));
+            } else if (code == 304) {
+                t->meta.checked = std::time(nullptr);
+                writeMeta(path, t->meta);
+                t->result = Result::NOT_MODIFIED;
+                std::cout << "[NET] " << t->job->url << " not modified" << std::endl;
+            } else if (!t->body.empty()) {
+                std::string tmp = path + ".tmp";
+                bool ok = false;
+                {
+                    std::ofstream out(tmp, std::ios::binary);
+                    ok = static_cast<bool>(out.write(t->body.data(), static_cast<std::streamsize>(t->body.size())));
+                }
+                if (ok && std::rename(tmp.c_str(), path.c_str()) == 0) {
+                    writeMeta(path, {t->response_etag, t->response_modified, std::time(nullptr)});
+                    t->result = Result::UPDATED;
+                    std::cout << "[NET] " << t->job->url << " OK (" << t->body.size() << " bytes)" << std::endl;
+                } else {
+                    std::remove(tmp.c_str());
+                    Logger::log("Could not write " + path);
+                }
+            }
+        }
+
+        std::vector<Result> results;
+        results.reserve(transfers.size());
+        for (auto& t : transfers) {
+            if (t.easy) {
+                curl_multi_remove_handle(multi_, t.easy);
+                curl_easy_cleanup(t.easy);
+            }
+            curl_slist_free_all(t.headers);
+            results.push_back(t.result);
+        }
+        return results;
+    }
+}
@@ -1,31 +1,55 @@
 #include "tle_manager.hpp"
 #include "logger.hpp"
+#include "mapped_file.hpp"
+#include "tle_catalog.hpp"
+#include "scheduler.hpp"
+#include "celestial_body.hpp"
 #include <iostream>
 #include <fstream>
 #include <filesystem>
-#include <curl/curl.h>
 #include <algorithm>
 #include <sys/stat.h>
 #include <ctime>
 #include <set>
 #include <sstream>
+#include <cctype>
 
 namespace ve {
-    TLEManager::TLEManager(const std::string& cache_dir) : cache_dir_(cache_dir) {
+    namespace {
+        std::string jsonEscape(const std::string& s) {
+            std::string out;
+            for (char c : s) {
+                if (c == '"' || c == '\\') out += '\\';
+                out += c;
+            }
+            return out;
+        }
+
+        std::string entriesJson(const std::vector<const CatalogEntry*>& entries) {
+            std::stringstream ss;
+            ss << "[";
+            for (size_t i = 0; i < entries.size(); ++i) {
+                const auto& e = *entries[i];
+                ss << "{\"id\":" << e.norad_id << ",\"n\":\"" << jsonEscape(e.name) << "\",\"intl\":\"" << jsonEscape(e.intl_designator)
+                   << "\",\"src\":\"" << jsonEscape(e.source) << "\"}";
+                if (i < entries.size() - 1) ss << ",";
+            }
+            ss << "]";
+            return ss.str();
+        }
+    }
+
+    TLEManager::TLEManager(const std::string& cache_dir) : cache_dir_(cache_dir), master_watcher_(cache_dir) {
         if (!std::filesystem::exists(cache_dir)) std::filesystem::create_directories(cache_dir);
     }
 
     void TLEManager::clearCache() { 
         for (const auto& entry : std::filesystem::directory_iterator(cache_dir_)) 
             std::filesystem::remove(entry.path());
+        invalidateMaster();
         std::cout << "[CACHE] Cleared." << std::endl;
     }
 
-    size_t TLEManager::WriteCallback(void* contents, size_t size, size_t nmemb, void* userp) {
-        ((std::string*)userp)->append((char*)contents, size * nmemb);
-        return size * nmemb;
-    }
-
     std::string TLEManager::trim(const std::string& str) {
         std::string s = str;
         s.erase(std::remove(s.begin(), s.end(), '\r'), s.end());
@@ -50,7 +74,9 @@ namespace ve {
         }
         if (attr.st_size == 0) { std::filesystem::remove(filepath); return false; }
         
-        std::time_t mod_time = attr.st_mtime;
+        // A 304 confirms the copy without rewriting it, so the age counts from
+        // whichever is later
+        std::time_t mod_time = std::max<std::time_t>(attr.st_mtime, TleFetcher::lastChecked(filepath));
         std::time_t now = std::time(nullptr);
         bool fresh = (std::difftime(now, mod_time) < 86400.0); 
         return fresh;
@@ -58,63 +84,56 @@ namespace ve {
 
     bool TLEManager::downloadFile(const std::string& url, const std::string& dest_path) {
         if (url.empty()) return false;
-        
-        CURL* curl = curl_easy_init(); 
-        if (!curl) return false;
-        
-        std::cout << "[NET] Downloading: " << url << " ... ";
-        std::flush(std::cout);
-
-        std::string readBuffer;
-        curl_easy_setopt(curl, CURLOPT_URL, url.c_str());
-        curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, WriteCallback);
-        curl_easy_setopt(curl, CURLOPT_WRITEDATA, &readBuffer);
-        curl_easy_setopt(curl, CURLOPT_USERAGENT, "VisibleEphemeris/12.112");
-        curl_easy_setopt(curl, CURLOPT_FOLLOWLOCATION, 1L);
-        curl_easy_setopt(curl, CURLOPT_FAILONERROR, 1L);
-        curl_easy_setopt(curl, CURLOPT_TIMEOUT, 45L);
-        
-        CURLcode res = curl_easy_perform(curl);
-        curl_easy_cleanup(curl);
-        
-        if (res != CURLE_OK || readBuffer.empty()) {
-            std::cout << "FAILED (" << curl_easy_strerror(res) << ")" << std::endl;
-            Logger::log("Download failed: " + std::string(curl_easy_strerror(res)));
-            return false;
-        }
-        
-        std::cout << "OK (" << readBuffer.length() << " bytes)" << std::endl;
-        std::ofstream outfile(dest_path); 
-        outfile << readBuffer; 
-        outfile.close();
-        return true;
+        auto result = fetcher_.fetch({{url, dest_path}}).front();
+        if (result == TleFetcher::Result::UPDATED) invalidateMaster();
+        return result != TleFetcher::Result::FAILED;
     }
 
     std::vector<Satellite> TLEManager::parseFile(const std::string& filepath) {
-        std::vector<Satellite> sats; 
-        std::ifstream file(filepath); 
-        std::string line, name, l1, l2;
-        if (!file.is_open()) return sats;
-        while (std::getline(file, line)) {
-            line = trim(line); if (line.length() < 2) continue;
-            if (line.substr(0, 2) == "1 " && !name.empty()) {
-                l1 = line;
-                if (std::getline(file, l2)) {
-                    l2 = trim(l2);
-                    if (l2.substr(0, 2) == "2 ") {
-                        name.erase(name.find_last_not_of(" \n\r\t")+1);
-                        try { sats.emplace_back(name, l1, l2); } catch(...) {}
-                        name = "";
-                    }
-                }
-            } else { name = line; }
+        // 1. Precompiled catalog, if it was built from this exact text
+        TleCatalog catalog;
+        if (catalog.open(filepath)) return satellitesOf(catalog.load());
+
+        // 2. Scan the mapped text in place; only the accepted records are copied out
+        MappedFile file(filepath);
+        if (!file.isOpen()) return {};
+        size_t rejected = 0;
+        auto records = scanTle(file.view(), &rejected);
+        if (rejected > 0) {
+            std::cerr << "[WARN] Dropped " << rejected << " malformed element sets in " << filepath << std::endl;
+        }
+        auto store = buildStore(records);
+        if (!TleCatalog::save(filepath, *store)) Logger::log("Could not write catalog for " + filepath);
+        return satellitesOf(store);
+    }
+
+    std::shared_ptr<ElementStore> TLEManager::buildStore(const std::vector<TleRecord>& records) {
+        auto store = std::make_shared<ElementStore>(records.size());
+        for (size_t i = 0; i < records.size(); ++i) store->setText(i, records[i].name, records[i].line1, records[i].line2);
+
+        // libsgp4 parsing and SGP4 init dominate the load; chunks fill their own slots
+        auto derive = [&](size_t begin, size_t end) {
+            for (size_t i = begin; i < end; ++i) Satellite::deriveRecord(*store, i);
+        };
+        if (scheduler_) scheduler_->parallel_for(records.size(), 64, derive);
+        else derive(0, records.size());
+        return store;
+    }
+
+    std::vector<Satellite> TLEManager::satellitesOf(const std::shared_ptr<const ElementStore>& store) {
+        std::vector<Satellite> sats;
+        sats.reserve(store->size());
+        for (size_t i = 0; i < store->size(); ++i) {
+            if (store->record(i).norad_id != 0) sats.emplace_back(store, i);
         }
+        Logger::log("Element store: " + std::to_string(sats.size()) + " sets, " +
+                    std::to_string(store->memoryBytes() / 1024) + " KiB");
         return sats;
     }
 
     std::string TLEManager::getUrlForGroup(const std::string& group) {
         std::string g = trim(group);
-        std::string base = "https://celestrak.org/NORAD/elements/gp.php?GROUP=";
+        std::string base = source_url_ + "?GROUP=";
         std::string suffix = "&FORMAT=tle";
 
         // --- MAPPING LOGIC ---
@@ -131,9 +150,7 @@ namespace ve {
         // Misc
         if (g == "military" || g == "radar" || g == "cubesat" || g == "other") return base + g + suffix;
 
-        // IF WE REACH HERE, IT IS UNKNOWN
-        std::cerr << "[ERROR] Unknown Group Name: [" << g << "]" << std::endl;
-        Logger::log("Unknown group: [" + g + "]. Skipping.");
+        // IF WE REACH HERE, IT IS UNKNOWN (a custom group if the file exists)
         return ""; 
     }
 
@@ -145,34 +162,46 @@ namespace ve {
         
         std::cout << "[TLE] Processing Group List: " << groups_list_str << std::endl;
 
+        // 1. Resolve every group; stale or missing ones are fetched together
+        std::vector<std::string> files;
+        std::vector<TleFetcher::Job> jobs;
         while(std::getline(ss, segment, ',')) {
             segment = trim(segment);
             if (segment.empty()) continue;
             
             std::string filename = cache_dir_ + "/" + segment + ".txt";
             bool is_local = std::filesystem::exists(filename);
-            bool is_custom = (segment == "user_defined"); // Or check file content logic? user_defined is special.
+            std::string url = (segment == "user_defined") ? "" : getUrlForGroup(segment);
             
-            if (!is_custom) {
-                std::string url = getUrlForGroup(segment);
-                if (url.empty()) {
-                    // Error printed in getUrlForGroup
-                    continue; 
-                }
-                
+            if (!url.empty()) {
                 if (is_local && isCacheFresh(filename)) {
                     std::cout << "[CACHE] Using cached data for: " << segment << std::endl;
                 } else {
-                    downloadFile(url, filename);
+                    jobs.push_back({url, filename});
                 }
+            } else if (is_local) {
+                std::cout << "[CACHE] Using Custom Group: " << segment << std::endl;
+            } else if (segment == "user_defined") {
+                std::cerr << "[ERROR] Custom group not found. Run Builder first." << std::endl;
+                continue;
             } else {
-                if (is_local) std::cout << "[CACHE] Using Custom Group: " << segment << std::endl;
-                else std::cerr << "[ERROR] Custom group not found. Run Builder first." << std::endl;
+                std::cerr << "[ERROR] Unknown Group Name: [" << segment << "]" << std::endl;
+                Logger::log("Unknown group: [" + segment + "]. Skipping.");
+                continue;
             }
+            files.push_back(filename);
+        }
+        if (!jobs.empty()) {
+            std::cout << "[NET] Fetching " << jobs.size() << " group(s) from " << source_url_ << std::endl;
+            auto results = fetcher_.fetch(jobs);
+            if (std::count(results.begin(), results.end(), TleFetcher::Result::UPDATED) > 0) invalidateMaster();
+        }
 
+        // 2. Parse in selection order; the first group listing an object keeps it
+        for (const auto& filename : files) {
             std::vector<Satellite> group_sats = parseFile(filename);
             if (group_sats.empty()) {
-                std::cerr << "[WARN] Group [" << segment << "] contained 0 satellites or failed to parse." << std::endl;
+                std::cerr << "[WARN] Group file [" << filename << "] contained 0 satellites or failed to parse." << std::endl;
             }
 
             for (auto& sat : group_sats) {
@@ -202,49 +231,103 @@ namespace ve {
             }
         }
 
-        // SYNTHETIC OBJECTS: SUN (-1) and MOON (-2)
-        // If explicitly requested, add them.
-        for(const auto& t : targets) {
-            if (t == "SUN") {
-                // Dummy TLE for Sun (Logic handles -1 ID specially)
-                results.emplace_back("SUN",
-                    "1 00001U 00001A   00001.00000000  .00000000  00000-0  00000-0 0    12",
-                    "2 00001   0.0000   0.0000 0000000   0.0000   0.0000  0.00000000    15");
-            } else if (t == "MOON") {
-                // Dummy TLE for Moon (Logic handles -2 ID specially)
-                results.emplace_back("MOON",
-                    "1 00002U 00002A   00001.00000000  .00000000  00000-0  00000-0 0    13",
-                    "2 00002   0.0000   0.0000 0000000   0.0000   0.0000  0.00000000    16");
-            }
-        }
+        // SUN and MOON are CelestialBody objects, not catalog entries (and must
+        // not pull in every name containing them)
+        targets.erase(std::remove_if(targets.begin(), targets.end(), CelestialBody::isBodyName), targets.end());
+        if (targets.empty()) return results;
 
         std::string active_file = cache_dir_ + "/active.txt";
         if (!isCacheFresh(active_file)) {
-            downloadFile("https://celestrak.org/NORAD/elements/gp.php?GROUP=active&FORMAT=tle", active_file);
-        }
-        std::ifstream file(active_file);
-        std::string line, name, l1, l2;
-        while (std::getline(file, line)) {
-            line = trim(line); if (line.length() < 2) continue;
-            if (line.substr(0, 2) == "1 " && !name.empty()) {
-                l1 = line;
-                if (std::getline(file, l2)) {
-                    l2 = trim(l2);
-                    std::string check_name = name;
-                    std::transform(check_name.begin(), check_name.end(), check_name.begin(), ::toupper);
-                    bool match = false;
-                    for(const auto& t : targets) { if (check_name.find(t) != std::string::npos) { match = true; break; } }
-                    if (match) {
-                        try { std::string n = name; n.erase(n.find_last_not_of(" \n\r\t")+1); results.emplace_back(n, l1, l2); } catch(...) {}
-                    }
-                    name = "";
-                }
-            } else { name = line; }
+            downloadFile(getUrlForGroup("active"), active_file);
+        }
+        // One automaton pass over the catalog for all names; only the hits get built
+        auto index = masterIndex();
+        std::vector<bool> hit;
+        auto matches = index->matchAny(targets, &hit);
+        for (size_t k = 0; k < targets.size(); ++k) {
+            if (!hit[k]) {
+                std::cerr << "[WARN] No catalog entry matches [" << targets[k] << "]" << std::endl;
+            }
         }
+        std::vector<TleRecord> records;
+        records.reserve(matches.size());
+        for (const auto* m : matches) records.push_back({m->name, m->line1, m->line2});
+        for (auto& sat : satellitesOf(buildStore(records))) results.push_back(std::move(sat));
         return results;
     }
 
-    std::string TLEManager::getFullCatalogJson() { return "[]"; } // Stub as builder removed
-    void TLEManager::saveCustomGroup(const std::string& group_name, const std::vector<int>& norad_ids) {}
-    std::string TLEManager::searchMasterCatalog(const std::string& query) { return "[]"; }
+    std::shared_ptr<const CatalogIndex> TLEManager::masterIndex() {
+        std::lock_guard<std::mutex> lock(master_mutex_);
+        if (master_ && master_watcher_.poll()) master_.reset();
+        if (master_) return master_;
+
+        // active.txt first so it wins for objects that are also in a group file
+        master_watcher_.snapshot();
+        std::vector<std::filesystem::path> files;
+        std::error_code ec;
+        for (const auto& entry : std::filesystem::directory_iterator(cache_dir_, ec)) {
+            if (entry.path().extension() == ".txt") files.push_back(entry.path());
+        }
+        std::sort(files.begin(), files.end(), [](const std::filesystem::path& a, const std::filesystem::path& b) {
+            bool aa = a.stem() == "active", ba = b.stem() == "active";
+            return aa != ba ? aa : a < b;
+        });
+        auto index = std::make_shared<CatalogIndex>();
+        for (const auto& path : files) {
+            MappedFile file(path.string());
+            for (const auto& r : scanTle(file.view())) index->add(r, path.stem().string());
+        }
+        index->build();
+        Logger::log("Catalog index: " + std::to_string(index->size()) + " objects from " + std::to_string(files.size()) + " files");
+        master_ = std::move(index);
+        return master_;
+    }
+
+    void TLEManager::invalidateMaster() {
+        std::lock_guard<std::mutex> lock(master_mutex_);
+        master_.reset();
+    }
+
+    std::string TLEManager::getFullCatalogJson() {
+        auto index = masterIndex();
+        std::vector<const CatalogEntry*> all;
+        all.reserve(index->size());
+        for (const auto& e : index->entries()) all.push_back(&e);
+        return entriesJson(all);
+    }
+
+    size_t TLEManager::saveCustomGroup(const std::string& group_name, const std::vector<int>& norad_ids) {
+        // Same file name rules as the Python builder
+        std::string name;
+        for (char c : group_name) {
+            if (std::isalnum(static_cast<unsigned char>(c)) || c == '-' || c == '_') name += c;
+        }
+        if (name.empty()) name = "user_defined";
+        // Never shadow a downloaded group: the truncated file would look fresh
+        // and its conditional fetch would keep answering 304
+        if (!getUrlForGroup(name).empty()) {
+            Logger::log("Custom group " + name + " rejected: name of a downloaded group");
+            return 0;
+        }
+
+        auto index = masterIndex();
+        std::string text;
+        size_t written = 0;
+        for (int id : norad_ids) {
+            const CatalogEntry* e = index->findNorad(id);
+            if (!e) { Logger::log("Custom group " + name + ": unknown NORAD id " + std::to_string(id)); continue; }
+            text += e->name + "\n" + e->line1 + "\n" + e->line2 + "\n";
+            written++;
+        }
+        if (written == 0) return 0;
+        std::ofstream outfile(cache_dir_ + "/" + name + ".txt");
+        outfile << text;
+        outfile.close();
+        Logger::log("Saved custom group " + name + " (" + std::to_string(written) + " objects)");
+        return written;
+    }
+
+    std::string TLEManager::searchMasterCatalog(const std::string& query, size_t limit) {
+        return entriesJson(masterIndex()->search(query, limit));
+    }
 }
@@ -0,0 +1,69 @@
+#include "tle_parser.hpp"
+
+namespace ve {
+    namespace {
+        constexpr size_t TLE_LINE_LEN = 69;
+
+        std::string_view trimView(std::string_view s) {
+            size_t first = s.find_first_not_of(" \t\r");
+            if (first == std::string_view::npos) return {};
+            size_t last = s.find_last_not_of(" \t\r");
+            return s.substr(first, last - first + 1);
+        }
+
+        bool startsWith(std::string_view line, char c) {
+            return line.size() >= 2 && line[0] == c && line[1] == ' ';
+        }
+
+        bool validPair(std::string_view l1, std::string_view l2) {
+            if (l1.size() < TLE_LINE_LEN || l2.size() < TLE_LINE_LEN) return false;
+            if (!tleChecksumOk(l1) || !tleChecksumOk(l2)) return false;
+            return l1.substr(2, 5) == l2.substr(2, 5);     // Catalog number
+        }
+    }
+
+    bool tleChecksumOk(std::string_view line) {
+        if (line.size() < TLE_LINE_LEN) return false;
+        int sum = 0;
+        for (size_t i = 0; i < TLE_LINE_LEN - 1; ++i) {
+            char c = line[i];
+            if (c >= '0' && c <= '9') sum += c - '0';
+            else if (c == '-') sum += 1;
+        }
+        char check = line[TLE_LINE_LEN - 1];
+        return check >= '0' && check <= '9' && (sum % 10) == check - '0';
+    }
+
+    std::vector<TleRecord> scanTle(std::string_view text, size_t* rejected) {
+        std::vector<TleRecord> out;
+        out.reserve(text.size() / (2 * TLE_LINE_LEN + 26));     // Typical record size
+        size_t dropped = 0;
+        size_t pos = 0;
+        auto nextLine = [&](std::string_view& line) {
+            if (pos >= text.size()) return false;
+            size_t end = text.find('\n', pos);
+            if (end == std::string_view::npos) end = text.size();
+            line = trimView(text.substr(pos, end - pos));
+            pos = end + 1;
+            return true;
+        };
+
+        std::string_view line, name;
+        while (nextLine(line)) {
+            if (line.size() < 2) continue;
+            if (startsWith(line, '1') && !name.empty()) {
+                std::string_view l2;
+                if (!nextLine(l2)) break;
+                if (startsWith(l2, '2')) {
+                    if (validPair(line, l2)) out.push_back({name, line, l2});
+                    else dropped++;
+                    name = {};
+                }
+            } else {
+                name = line;
+            }
+        }
+        if (rejected) *rejected = dropped;
+        return out;
+    }
+}
@@ -1,8 +1,52 @@
 #include "visibility.hpp"
+#include "frame_context.hpp"
+#include <algorithm>
 #include <cmath>
 #include <iostream>
 
 namespace ve {
+    namespace {
+        // Thresholds fixed at start-up so the per-object tests need no trig
+        const double SIN_CIVIL = std::sin(6.0 * DEG2RAD);       // Sun below -6 deg: satellites visible
+        const double SIN_NAUTICAL = std::sin(12.0 * DEG2RAD);   // Sun below -12 deg: flares visible
+        const double COS2_FLARE_HIT = std::cos(0.5 * DEG2RAD) * std::cos(0.5 * DEG2RAD);
+        const double COS2_FLARE_NEAR = std::cos(1.0 * DEG2RAD) * std::cos(1.0 * DEG2RAD);
+        constexpr double FLARE_MAX_APOGEE_KM = 1000.0;
+        constexpr double RE2 = EARTH_RADIUS_KM * EARTH_RADIUS_KM;
+
+        // Sun elevation at the observer below -asin(sin_depth)
+        inline bool sunBelow(const Vector3& obs, const Vector3& sun, double sin_depth) {
+            return obs.dot(sun) < -sin_depth * std::sqrt(obs.dot(obs) * sun.dot(sun));
+        }
+
+        // Night side of the earth (d < 0) and closer to the anti-sun line than
+        // the umbra half-angle asin(Re / r): cos^2 > 1 - Re^2 / r^2, scaled by r^2
+        inline bool inUmbra(double x, double y, double z, double sdx, double sdy, double sdz) {
+            double d = x * sdx + y * sdy + z * sdz;
+            double r2 = x * x + y * y + z * z;
+            return (d < 0.0) & (d * d > r2 - RE2);
+        }
+
+        // Nadir-facing mirror. The sun-to-satellite ray i is reflected about the
+        // local vertical, scaled by |s|^2 instead of normalized, and its squared
+        // cosine with the satellite-to-observer vector v compared to the cones
+        inline int flareCode(double x, double y, double z, double ox, double oy, double oz,
+                             double sx, double sy, double sz, double cos2_hit, double cos2_near) {
+            double ix = x - sx, iy = y - sy, iz = z - sz;
+            double nn = x * x + y * y + z * z;
+            double in = ix * x + iy * y + iz * z;               // > 0: light reaches the earth-facing side
+            double rx = nn * ix - 2.0 * in * x;
+            double ry = nn * iy - 2.0 * in * y;
+            double rz = nn * iz - 2.0 * in * z;
+            double vx = ox - x, vy = oy - y, vz = oz - z;
+            double rv = rx * vx + ry * vy + rz * vz;
+            double rr_vv = (rx * rx + ry * ry + rz * rz) * (vx * vx + vy * vy + vz * vz);
+            // The hit cone lies inside the near cone, so the two tests sum to 2 / 1 / 0
+            int code = (rv * rv > cos2_hit * rr_vv) + (rv * rv > cos2_near * rr_vv);
+            return code * ((in > 0.0) & (rv > 0.0));
+        }
+    }
+
     Vector3 VisibilityCalculator::getSunPositionECI(const TimePoint& t) {
         double n = toJulianDate(t) - 2451545.0; 
         double L = std::fmod(280.460 + 0.9856474 * n, 360.0); if (L<0) L+=360;
@@ -31,55 +75,68 @@ namespace ve {
 
     VisibilityCalculator::State VisibilityCalculator::calculateState(const Vector3& sat, const Vector3& obs, const TimePoint& t, double el) {
         Vector3 sun = getSunPositionECI(t);
-        double umbra = std::asin(EARTH_RADIUS_KM / sat.magnitude());
-        double angle = std::acos(sat.normalize().dot(sun.normalize()));
-        bool lit = (angle < (PI/2.0)) || ((PI - angle) >= umbra);
-        if (!lit) return State::ECLIPSED;
-        double sun_el = (PI/2.0) - std::acos(obs.normalize().dot(sun.normalize()));
-        if (sun_el < (-6.0 * DEG2RAD)) return State::VISIBLE;
+        Vector3 sd = sun.normalize();
+        if (inUmbra(sat.x, sat.y, sat.z, sd.x, sd.y, sd.z)) return State::ECLIPSED;
+        return sunBelow(obs, sun, SIN_CIVIL) ? State::VISIBLE : State::DAYLIGHT;
+    }
+
+    VisibilityCalculator::State VisibilityCalculator::calculateState(const Vector3& sat, const FrameContext& ctx) {
+        const Vector3& sd = ctx.sun_dir;
+        if (inUmbra(sat.x, sat.y, sat.z, sd.x, sd.y, sd.z)) return State::ECLIPSED;
+        if (ctx.sun_el < (-6.0 * DEG2RAD)) return State::VISIBLE;
         return State::DAYLIGHT;
     }
 
+    int VisibilityCalculator::checkFlare(const Vector3& sat_eci, const FrameContext& ctx, double apogee_km) {
+        // Observer twilight is shared by every satellite in the tick
+        if (apogee_km > FLARE_MAX_APOGEE_KM) return 0;
+        if (ctx.sun_el >= (-12.0 * DEG2RAD)) return 0;
+        return flareCode(sat_eci.x, sat_eci.y, sat_eci.z, ctx.obs_pos.x, ctx.obs_pos.y, ctx.obs_pos.z,
+                         ctx.sun.x, ctx.sun.y, ctx.sun.z, COS2_FLARE_HIT, COS2_FLARE_NEAR);
+    }
+
     int VisibilityCalculator::checkFlare(const Vector3& sat_eci, const Vector3& obs_eci, const Vector3& sun_eci, double apogee_km) {
         // 1. Check LEO (<1000 km)
-        if (apogee_km > 1000.0) return 0;
+        if (apogee_km > FLARE_MAX_APOGEE_KM) return 0;
 
         // 2. Check Observer Twilight (Sun Elevation < -12 deg)
-        // Angle between Obs and Sun
-        double angle_obs_sun = std::acos(obs_eci.normalize().dot(sun_eci.normalize()));
-        // Elevation = 90 - Angle
-        double sun_el_obs = (PI / 2.0) - angle_obs_sun;
-        if (sun_el_obs >= (-12.0 * DEG2RAD)) return 0; // Not dark enough
-
-        // 3. Mirror Geometry
-        // Normal points to Earth Center: N = -sat_eci.normalized()
-        Vector3 N = sat_eci.normalize() * -1.0;
+        if (!sunBelow(obs_eci, sun_eci, SIN_NAUTICAL)) return 0;
 
-        // Incident Light Vector (Sun to Sat): I = (Sat - Sun).normalized()
-        Vector3 I = (sat_eci - sun_eci).normalize();
-
-        // Check if light hits the Nadir-facing surface
-        // Condition: I . N < 0 (Opposing vectors)
-        if (I.dot(N) >= 0) return 0; // Light hitting Zenith side
-
-        // Reflection Vector: R = I - 2(I . N)N
-        double dot_IN = I.dot(N);
-        Vector3 R = I - (N * (2.0 * dot_IN));
-
-        // Vector to Observer: V = (Obs - Sat).normalized()
-        Vector3 V = (obs_eci - sat_eci).normalize();
-
-        // Check Angle between Reflection and Observer
-        double dot_RV = R.normalize().dot(V);
-        if (dot_RV > 1.0) dot_RV = 1.0; // Clamp
-        if (dot_RV < -1.0) dot_RV = -1.0;
-
-        double angle_diff_rad = std::acos(dot_RV);
-        double angle_diff_deg = angle_diff_rad * RAD2DEG;
+        // 3. Mirror Geometry: HIT inside 0.5 deg of the reflection, NEAR inside 1.0 deg
+        return flareCode(sat_eci.x, sat_eci.y, sat_eci.z, obs_eci.x, obs_eci.y, obs_eci.z,
+                         sun_eci.x, sun_eci.y, sun_eci.z, COS2_FLARE_HIT, COS2_FLARE_NEAR);
+    }
 
-        if (angle_diff_deg < 0.5) return 2; // HIT
-        if (angle_diff_deg < 1.0) return 1; // NEAR
+    void VisibilityCalculator::calculateStates(const double* px, const double* py, const double* pz, size_t count,
+                                               const Vector3& obs_eci, const Vector3& sun_eci, State* out) {
+        // 1. Per call: sun direction and observer twilight
+        Vector3 sd = sun_eci.normalize();
+        const double sdx = sd.x, sdy = sd.y, sdz = sd.z;
+        const State lit = sunBelow(obs_eci, sun_eci, SIN_CIVIL) ? State::VISIBLE : State::DAYLIGHT;
+
+        // 2. Per object: umbra test only
+        for (size_t i = 0; i < count; ++i) {
+            out[i] = inUmbra(px[i], py[i], pz[i], sdx, sdy, sdz) ? State::ECLIPSED : lit;
+        }
+    }
 
-        return 0;
+    void VisibilityCalculator::checkFlares(const double* px, const double* py, const double* pz, const double* apogee_km,
+                                           const State* state, size_t count, const Vector3& obs_eci, const Vector3& sun_eci, int8_t* out) {
+        // 1. Too light for flares anywhere in the batch
+        if (!sunBelow(obs_eci, sun_eci, SIN_NAUTICAL)) {
+            std::fill(out, out + count, int8_t{0});
+            return;
+        }
+
+        // 2. Mirror geometry for every object, masked by state and apogee
+        const double ox = obs_eci.x, oy = obs_eci.y, oz = obs_eci.z;
+        const double sx = sun_eci.x, sy = sun_eci.y, sz = sun_eci.z;
+        // Thresholds in locals: out is a char type and may alias the globals
+        const double hit = COS2_FLARE_HIT, near = COS2_FLARE_NEAR;
+        for (size_t i = 0; i < count; ++i) {
+            int code = flareCode(px[i], py[i], pz[i], ox, oy, oz, sx, sy, sz, hit, near);
+            int eligible = (state[i] == State::VISIBLE) & (apogee_km[i] <= FLARE_MAX_APOGEE_KM);
+            out[i] = static_cast<int8_t>(code * eligible);
+        }
     }
 }
@@ -9,6 +9,8 @@
 #include <unistd.h>
 #include <fcntl.h> 
 #include <algorithm>
+#include <cctype>
+#include <cstdlib>
 
 namespace ve {
 
@@ -339,11 +341,6 @@ namespace ve {
     void WebServer::start() { running_ = true; server_thread_ = std::thread(&WebServer::serverLoop, this); }
     void WebServer::runBlocking() { running_ = true; serverLoop(); }
     void WebServer::stop() { running_ = false; if (server_fd_ >= 0) { shutdown(server_fd_, SHUT_RDWR); close(server_fd_); server_fd_ = -1; } if(server_thread_.joinable()) server_thread_.join(); }
-    void WebServer::updateData(const std::vector<DisplayRow>& rows, const std::vector<Satellite*>& raw_sats, const AppConfig& config, const TimePoint& t, const std::string& time_str) {
-        std::lock_guard<std::mutex> lock(data_mutex_);
-        current_json_data_ = buildJson(rows, raw_sats, config, t, time_str);
-        last_known_config_ = config;
-    }
     bool WebServer::hasPendingConfig() { std::lock_guard<std::mutex> lock(config_mutex_); return config_changed_; }
     AppConfig WebServer::popPendingConfig() { std::lock_guard<std::mutex> lock(config_mutex_); config_changed_ = false; return pending_config_; }
 
@@ -351,7 +348,7 @@ namespace ve {
         return selected_norad_id_.load();
     }
 
-    std::string WebServer::buildJson(const std::vector<DisplayRow>& rows, const std::vector<Satellite*>& raw_sats, const AppConfig& config, const TimePoint& t, const std::string& time_str) {
+    std::string WebServer::buildJson(const std::vector<DisplayRow>& rows, const AppConfig& config, const TimePoint& t, const std::string& time_str) {
         std::stringstream ss;
         Geodetic sun = VisibilityCalculator::getSunPositionGeo(t);
 
@@ -365,13 +362,44 @@ namespace ve {
             const auto& r = rows[i];
             ss << "{\"id\":" << r.norad_id << ",\"n\":\"" << r.name << "\",\"lat\":" << r.lat << ",\"lon\":" << r.lon 
                << ",\"a\":" << r.az << ",\"e\":" << r.el << ",\"v\":\"" << (r.state==VisibilityCalculator::State::VISIBLE?"YES":(r.state==VisibilityCalculator::State::DAYLIGHT?"DAY":"NO")) 
-               << "\",\"next\":\"" << r.next_event << "\",\"apo\":" << r.apogee << ",\"f\":" << r.flare_status << "}";
+               << "\",\"next\":\"" << formatNextEvent(r, t) << "\",\"apo\":" << r.apogee << ",\"f\":" << r.flare_status << "}";
             if(i < rows.size()-1) ss << ",";
         }
         ss << "]}"; 
         return ss.str();
     }
 
+    std::string WebServer::buildQuarantineJson(const std::vector<Satellite>& sats) {
+        std::stringstream ss;
+        ss << "{\"quarantined\":[";
+        bool first = true;
+        for (const auto& sat : sats) {
+            if (!sat.isQuarantined()) continue;
+            if (!first) ss << ",";
+            first = false;
+            ss << "{\"id\":" << sat.getNoradId() << ",\"n\":\"" << sat.getName() << "\",\"status\":\""
+               << trackStatusName(sat.getStatus()) << "\",\"apo\":" << sat.getApogeeKm() << "}";
+        }
+        ss << "]}";
+        return ss.str();
+    }
+
+    std::string WebServer::buildPassesJson(const EventTimeline& timeline, const std::vector<const EventTimeline::Pass*>& passes, const TimePoint& t) {
+        auto to_unix = [](const TimePoint& tp) { return static_cast<long long>(Clock::to_time_t(tp)); };
+        std::stringstream ss;
+        ss << "{\"time\":" << to_unix(t) << ",\"passes\":[";
+        for (size_t i = 0; i < passes.size(); ++i) {
+            const auto& p = *passes[i];
+            ss << "{\"id\":" << p.norad_id << ",\"n\":\"" << timeline.name(p) << "\",\"aos\":" << to_unix(p.aos)
+               << ",\"tca\":" << to_unix(p.tca) << ",\"los\":" << to_unix(p.los) << ",\"max_el\":" << p.max_el
+               << ",\"aos_az\":" << p.aos_az << ",\"tca_az\":" << p.tca_az << ",\"los_az\":" << p.los_az
+               << ",\"rise\":" << (p.has_aos ? "true" : "false") << ",\"set\":" << (p.has_los ? "true" : "false") << "}";
+            if (i < passes.size() - 1) ss << ",";
+        }
+        ss << "]}";
+        return ss.str();
+    }
+
     std::string WebServer::urlDecode(const std::string& str) {
         std::string ret; for (size_t i=0; i < str.length(); i++) { if(str[i] != '%'){ if(str[i] == '+') ret += ' '; else ret += str[i]; } else { int ii; sscanf(str.substr(i + 1, 2).c_str(), "%x", &ii); ret += static_cast<char>(ii); i += 2; } } return ret;
     }
@@ -385,6 +413,54 @@ namespace ve {
         std::string clean_path = path.substr(0, path.find('?'));
         auto params = parseQuery(path.substr(path.find('?') + 1));
 
+        // Saving a picked set as a group writes into the TLE cache: builder mode
+        // only, and only as a POST with a form body (name=&ids=1,2,3)
+        if (clean_path == "/api/group") {
+            if (!builder_mode_ || method != "POST") {
+                std::string body = "{\"status\":\"error\", \"message\":\"POST in builder mode only\"}";
+                std::string header = "HTTP/1.1 405 Method Not Allowed\r\nAllow: POST\r\nContent-Type: application/json\r\nConnection: close\r\nContent-Length: " + std::to_string(body.length()) + "\r\n\r\n";
+                sendAll(client_socket, header, body);
+                return;
+            }
+            try {
+                size_t body_pos = request.find("\r\n\r\n");
+                auto form = parseQuery(body_pos == std::string::npos ? std::string() : request.substr(body_pos + 4));
+                std::vector<int> ids;
+                std::stringstream ids_ss(form["ids"]);
+                std::string id;
+                while (std::getline(ids_ss, id, ',')) if (!id.empty()) ids.push_back(std::stoi(id));
+                size_t written = tle_mgr_.saveCustomGroup(form["name"], ids);
+                std::string body = "{\"status\":\"" + std::string(written > 0 ? "ok" : "error") + "\",\"saved\":" + std::to_string(written) + "}";
+                std::string header = "HTTP/1.1 200 OK\r\nContent-Type: application/json\r\nCache-Control: no-cache, no-store\r\nContent-Length: " + std::to_string(body.length()) + "\r\n\r\n";
+                sendAll(client_socket, header, body);
+            } catch (...) {
+                std::string body = "{\"status\":\"error\", \"message\":\"Invalid group request\"}";
+                std::string header = "HTTP/1.1 400 Bad Request\r\nContent-Type: application/json\r\nConnection: close\r\nContent-Length: " + std::to_string(body.length()) + "\r\n\r\n";
+                sendAll(client_socket, header, body);
+            }
+            return;
+        }
+
+        // Catalog endpoints serve both modes: ?q= type-ahead search and the full index
+        if (clean_path == "/api/search" || clean_path == "/api/catalog") {
+            try {
+                std::string body;
+                if (clean_path == "/api/search") {
+                    size_t limit = params.count("limit") ? std::stoul(params["limit"]) : 50;
+                    body = tle_mgr_.searchMasterCatalog(params["q"], std::min<size_t>(std::max<size_t>(limit, 1), 1000));
+                } else {
+                    body = tle_mgr_.getFullCatalogJson();
+                }
+                std::string header = "HTTP/1.1 200 OK\r\nContent-Type: application/json\r\nCache-Control: no-cache, no-store\r\nContent-Length: " + std::to_string(body.length()) + "\r\n\r\n";
+                sendAll(client_socket, header, body);
+            } catch (...) {
+                std::string body = "{\"status\":\"error\", \"message\":\"Invalid catalog request\"}";
+                std::string header = "HTTP/1.1 400 Bad Request\r\nContent-Type: application/json\r\nConnection: close\r\nContent-Length: " + std::to_string(body.length()) + "\r\n\r\n";
+                sendAll(client_socket, header, body);
+            }
+            return;
+        }
+
         // Stub for builder HTML since we removed it from this file to focus on tracker fix
         // In a real full merge, builder HTML would be here.
         if (builder_mode_) {
@@ -395,9 +471,46 @@ namespace ve {
         }
 
         if (clean_path == "/api/satellites") {
-            std::lock_guard<std::mutex> lock(data_mutex_);
-            std::string resp = "HTTP/1.1 200 OK\r\nContent-Type: application/json\r\nCache-Control: no-cache, no-store\r\nContent-Length: " + std::to_string(current_json_data_.length()) + "\r\n\r\n" + current_json_data_;
-            send(client_socket, resp.c_str(), resp.length(), MSG_NOSIGNAL);
+            // Hold the frame for the duration of the send; the math thread may publish meanwhile
+            auto frame = frames_ ? frames_->latest() : nullptr;
+            static const std::string empty = "{\"satellites\":[]}";
+            const std::string& body = frame ? frame->json : empty;
+            std::string header = "HTTP/1.1 200 OK\r\nContent-Type: application/json\r\nCache-Control: no-cache, no-store\r\nContent-Length: " + std::to_string(body.length()) + "\r\n\r\n";
+            sendAll(client_socket, header, body);
+        } else if (clean_path == "/api/passes") {
+            // ?from=&to= (Unix seconds) for a window, otherwise the next passes from now;
+            // min_el filters on culmination, limit caps the list
+            auto frame = frames_ ? frames_->latest() : nullptr;
+            try {
+                size_t limit = params.count("limit") ? std::stoul(params["limit"]) : 50;
+                limit = std::min<size_t>(std::max<size_t>(limit, 1), 1000);
+                double min_el = params.count("min_el") ? std::stod(params["min_el"]) : 0.0;
+                std::string body = "{\"passes\":[]}";
+                if (frame && frame->timeline) {
+                    std::vector<const EventTimeline::Pass*> passes;
+                    if (params.count("from") || params.count("to")) {
+                        TimePoint from = params.count("from") ? Clock::from_time_t(std::stoll(params["from"])) : frame->time;
+                        TimePoint to = params.count("to") ? Clock::from_time_t(std::stoll(params["to"])) : from + std::chrono::hours(24);
+                        passes = frame->timeline->query(from, to, min_el);
+                        if (passes.size() > limit) passes.resize(limit);
+                    } else {
+                        passes = frame->timeline->nextPasses(frame->time, limit, min_el);
+                    }
+                    body = buildPassesJson(*frame->timeline, passes, frame->time);
+                }
+                std::string header = "HTTP/1.1 200 OK\r\nContent-Type: application/json\r\nCache-Control: no-cache, no-store\r\nContent-Length: " + std::to_string(body.length()) + "\r\n\r\n";
+                sendAll(client_socket, header, body);
+            } catch (...) {
+                std::string body = "{\"status\":\"error\", \"message\":\"Invalid pass query\"}";
+                std::string header = "HTTP/1.1 400 Bad Request\r\nContent-Type: application/json\r\nConnection: close\r\nContent-Length: " + std::to_string(body.length()) + "\r\n\r\n";
+                sendAll(client_socket, header, body);
+            }
+        } else if (clean_path == "/api/quarantine") {
+            auto frame = frames_ ? frames_->latest() : nullptr;
+            static const std::string empty = "{\"quarantined\":[]}";
+            const std::string& body = (frame && frame->quarantine_json) ? *frame->quarantine_json : empty;
+            std::string header = "HTTP/1.1 200 OK\r\nContent-Type: application/json\r\nCache-Control: no-cache, no-store\r\nContent-Length: " + std::to_string(body.length()) + "\r\n\r\n";
+            sendAll(client_socket, header, body);
         } else if (clean_path.rfind("/api/select/", 0) == 0) {
             try {
                 std::string id_str = clean_path.substr(12);
@@ -417,12 +530,30 @@ namespace ve {
             send(client_socket, resp.c_str(), resp.length(), MSG_NOSIGNAL);
         }
     }
+    void WebServer::readBody(int client_socket, std::string& request) {
+        // A POST body may arrive after the first read; take up to Content-Length
+        size_t header_end = request.find("\r\n\r\n");
+        if (header_end == std::string::npos) return;
+        std::string head = request.substr(0, header_end);
+        std::transform(head.begin(), head.end(), head.begin(), [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+        size_t cl = head.find("\r\ncontent-length:");
+        if (cl == std::string::npos) return;
+        size_t length = std::strtoul(head.c_str() + cl + 17, nullptr, 10);
+        size_t want = header_end + 4 + std::min(length, MAX_BODY_BYTES);
+        char buffer[4096];
+        while (request.size() < want) {
+            int bytes = read(client_socket, buffer, std::min(sizeof(buffer), want - request.size()));
+            if (bytes <= 0) break;
+            request.append(buffer, bytes);
+        }
+    }
+
     void WebServer::serverLoop() {
         while (running_) {
             int new_socket = accept(server_fd_, NULL, NULL);
             if (new_socket >= 0) {
                 char buffer[4096]; int bytes = read(new_socket, buffer, 4096);
-                if (bytes > 0) { std::string request(buffer, bytes); handleRequest(new_socket, request); }
+                if (bytes > 0) { std::string request(buffer, bytes); readBody(new_socket, request); handleRequest(new_socket, request); }
                 shutdown(new_socket, SHUT_WR); char drain[128]; while(read(new_socket, drain, sizeof(drain)) > 0); close(new_socket);
             } else { if (!running_) break; std::this_thread::sleep_for(std::chrono::milliseconds(100)); }
         }
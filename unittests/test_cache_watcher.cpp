@@ -0,0 +1,54 @@
+#include <iostream>
+#include <cassert>
+#include <fstream>
+#include <filesystem>
+#include "../include/cache_watcher.hpp"
+
+using namespace ve;
+
+// Standalone: g++ -std=c++17 -I../include test_cache_watcher.cpp ../src/cache_watcher.cpp
+
+namespace fs = std::filesystem;
+
+void write(const fs::path& p, const std::string& text) {
+    std::ofstream(p) << text;
+}
+
+void test_settle_and_filter() {
+    fs::path dir = fs::temp_directory_path() / "ve_test_cache_watcher";
+    fs::remove_all(dir);
+    fs::create_directories(dir);
+    write(dir / "active.txt", "ISS\n");
+    CacheWatcher w(dir.string());
+
+    // Nothing changed; other extensions are ignored
+    write(dir / "active.catalog", "binary");
+    bool ok = !w.poll() && !w.poll();
+
+    // A new file is reported on the second identical read, then only once
+    write(dir / "stations.txt", "ISS\n");
+    ok = ok && !w.poll() && w.poll() && !w.poll();
+
+    // Still growing between polls: held back until it settles
+    write(dir / "stations.txt", "ISS\nMORE\n");
+    ok = ok && !w.poll();
+    write(dir / "stations.txt", "ISS\nMORE\nEVEN MORE\n");
+    ok = ok && !w.poll() && w.poll();
+
+    // Removal counts; a snapshot absorbs changes we made ourselves
+    fs::remove(dir / "active.txt");
+    ok = ok && !w.poll() && w.poll();
+    write(dir / "active.txt", "ISS\n");
+    w.snapshot();
+    ok = ok && !w.poll() && !w.poll();
+
+    fs::remove_all(dir);
+    std::cout << "Test 1 (Settled changes, extension filter, snapshot): " << ok << " (Expected 1)" << std::endl;
+    assert(ok);
+}
+
+int main() {
+    test_settle_and_filter();
+    std::cout << "ALL TESTS PASSED" << std::endl;
+    return 0;
+}
@@ -0,0 +1,95 @@
+#include <iostream>
+#include <cassert>
+#include <vector>
+#include <memory>
+#include "../include/catalog_diff.hpp"
+
+using namespace ve;
+
+// Standalone: g++ -std=c++17 -I../include test_catalog_diff.cpp
+
+// Stand-in for Satellite: move-only, with state that must survive a merge
+struct FakeSat {
+    int id;
+    uint64_t hash;
+    std::unique_ptr<int> passes;
+    bool adopted = false;
+    FakeSat(int i, uint64_t h, int p = 0) : id(i), hash(h), passes(p ? std::make_unique<int>(p) : nullptr) {}
+    int getNoradId() const { return id; }
+    uint64_t getTleHash() const { return hash; }
+    void adoptElements(const FakeSat&) { adopted = true; }
+};
+
+std::vector<FakeSat> makeLive() {
+    std::vector<FakeSat> v;
+    v.emplace_back(100, 1, 11);
+    v.emplace_back(200, 2, 22);
+    v.emplace_back(300, 3, 33);
+    return v;
+}
+
+void test_mixed() {
+    // 100 unchanged, 200 new elements, 300 gone, 400 new; fresh order wins
+    auto live = makeLive();
+    std::vector<FakeSat> fresh;
+    fresh.emplace_back(400, 4);
+    fresh.emplace_back(200, 9);
+    fresh.emplace_back(100, 1);
+    CatalogDiff d = mergeCatalog(live, std::move(fresh));
+    bool ok = d.kept == 1 && d.changed == 1 && d.added == 1 && d.removed == 1 && live.size() == 3;
+    ok = ok && live[0].id == 400 && live[1].id == 200 && live[2].id == 100;
+    ok = ok && !live[0].passes && !live[1].passes && live[2].passes && *live[2].passes == 11;
+    ok = ok && !live[0].adopted && !live[1].adopted && live[2].adopted;
+    std::cout << "Test 1 (Kept state, changed/added/removed): " << ok << " (Expected 1)" << std::endl;
+    assert(ok);
+}
+
+void test_unchanged_untouched() {
+    // Same set in another order: nothing moves, so indices stay valid
+    auto live = makeLive();
+    const FakeSat* first = &live[0];
+    std::vector<FakeSat> fresh;
+    fresh.emplace_back(300, 3);
+    fresh.emplace_back(100, 1);
+    fresh.emplace_back(200, 2);
+    CatalogDiff d = mergeCatalog(live, std::move(fresh));
+    bool ok = d.unchanged() && !d.swapped && d.kept == 3 && &live[0] == first && live[0].id == 100 && *live[0].passes == 11;
+    std::cout << "Test 2 (Unchanged set leaves live alone): " << ok << " (Expected 1)" << std::endl;
+    assert(ok);
+}
+
+void test_duplicates_and_empty_live() {
+    // Two live copies of one element set pair with two fresh copies, in order
+    std::vector<FakeSat> live;
+    live.emplace_back(500, 5, 1);
+    live.emplace_back(500, 5, 2);
+    std::vector<FakeSat> fresh;
+    fresh.emplace_back(500, 5);
+    fresh.emplace_back(500, 5);
+    fresh.emplace_back(600, 6);
+    CatalogDiff d = mergeCatalog(live, std::move(fresh));
+    bool ok = d.kept == 2 && d.added == 1 && d.swapped && *live[0].passes == 1 && *live[1].passes == 2 && live[2].id == 600;
+
+    // A duplicate dropped from the fresh set changes nothing but still swaps
+    std::vector<FakeSat> dup;
+    dup.emplace_back(500, 5);
+    dup.emplace_back(600, 6);
+    d = mergeCatalog(live, std::move(dup));
+    ok = ok && d.unchanged() && d.swapped && live.size() == 2;
+
+    std::vector<FakeSat> none;
+    std::vector<FakeSat> all;
+    all.emplace_back(700, 7);
+    d = mergeCatalog(none, std::move(all));
+    ok = ok && d.added == 1 && d.kept == 0 && none.size() == 1;
+    std::cout << "Test 3 (Duplicates, dropped duplicate and first load): " << ok << " (Expected 1)" << std::endl;
+    assert(ok);
+}
+
+int main() {
+    test_mixed();
+    test_unchanged_untouched();
+    test_duplicates_and_empty_live();
+    std::cout << "ALL TESTS PASSED" << std::endl;
+    return 0;
+}
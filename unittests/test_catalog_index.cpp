@@ -0,0 +1,109 @@
+#include <iostream>
+#include <cassert>
+#include <string>
+#include <vector>
+#include <random>
+#include <algorithm>
+#include "../include/catalog_index.hpp"
+
+using namespace ve;
+
+// Standalone: g++ -std=c++17 -I../include test_catalog_index.cpp ../src/catalog_index.cpp ../src/tle_parser.cpp
+
+// Lines only need the catalog number and designator columns for indexing
+struct Fixture {
+    std::vector<std::string> store;
+    CatalogIndex index;
+
+    void add(const std::string& name, int id, const std::string& desig, const std::string& source = "active") {
+        char l1[70], l2[70];
+        std::snprintf(l1, sizeof(l1), "1 %05dU %-8s 08264.51782528 -.00002182  00000-0 -11606-4 0  2927", id, desig.c_str());
+        std::snprintf(l2, sizeof(l2), "2 %05d  51.6416 247.4627 0006703 130.5360 325.0288 15.72125391563537", id);
+        store.push_back(name);
+        store.push_back(l1);
+        store.push_back(l2);
+    }
+    void build() {
+        for (size_t i = 0; i < store.size(); i += 3) index.add({store[i], store[i + 1], store[i + 2]}, "active");
+        index.build();
+    }
+};
+
+std::vector<int> ids(const std::vector<const CatalogEntry*>& v) {
+    std::vector<int> out;
+    for (auto* e : v) out.push_back(e->norad_id);
+    return out;
+}
+
+void test_normalize_and_keys() {
+    bool ok = CatalogIndex::normalize("  iss (Zarya) ") == "ISS ZARYA" && CatalogIndex::normalize("NOAA-19") == "NOAA 19" &&
+              CatalogIndex::designatorKey("1998-067A") == "98067A" && CatalogIndex::designatorKey("98067a") == "98067A" &&
+              CatalogIndex::designatorKey("2024-1") == "241" && CatalogIndex::designatorKey("1998-06A").empty() &&
+              CatalogIndex::designatorKey("ISS").empty() && CatalogIndex::designatorKey("980").empty();
+    std::cout << "Test 1 (Normalization and designator keys): " << ok << " (Expected 1)" << std::endl;
+    assert(ok);
+}
+
+void test_search_order() {
+    Fixture f;
+    f.add("ISS (ZARYA)", 25544, "98067A");
+    f.add("NOAA 19", 33591, "09005A");
+    f.add("NOAA 18", 28654, "05018A");
+    f.add("CSS (TIANHE)", 48274, "21035A");
+    f.add("FENGYUN 1C DEB", 29000, "99025AAA");
+    f.add("DUPLICATE ISS", 25544, "98067A");     // Same id: first one wins
+    f.build();
+    const CatalogIndex& idx = f.index;
+
+    bool ok = idx.size() == 5 && idx.findNorad(25544)->name == "ISS (ZARYA)" && idx.findNorad(1) == nullptr;
+    ok = ok && ids(idx.search("25544", 10)) == std::vector<int>{25544};
+    ok = ok && ids(idx.search("1998-067", 10)) == std::vector<int>{25544};
+    ok = ok && ids(idx.search("noaa", 10)) == (std::vector<int>{28654, 33591});       // Prefix, name order
+    ok = ok && ids(idx.search("tianhe", 10)) == std::vector<int>{48274};              // Substring via trigrams
+    ok = ok && ids(idx.search("ss", 10)).empty();                                     // Too short for substring
+    ok = ok && ids(idx.search("iss (zarya", 10)) == std::vector<int>{25544};         // Punctuation ignored
+    ok = ok && ids(idx.search("ss (t", 10)) == std::vector<int>{48274};
+    ok = ok && idx.search("noaa", 1).size() == 1 && idx.search("", 10).empty();
+    std::cout << "Test 2 (Search groups and order): " << ok << " (Expected 1)" << std::endl;
+    assert(ok);
+}
+
+void test_match_any_vs_scan() {
+    // Random names against many patterns: the automaton must agree with one find() per pattern
+    Fixture f;
+    std::mt19937 rng(5);
+    const char* words[] = {"STARLINK", "NOAA", "ISS", "COSMOS", "DEB", "R/B", "GPS", "BIIR", "1", "12", "ONEWEB"};
+    for (int i = 0; i < 2000; ++i) {
+        std::string name = words[rng() % 11];
+        for (int w = rng() % 3; w > 0; --w) name += std::string(rng() % 2 ? "-" : " ") + words[rng() % 11];
+        f.add(name, 10000 + i, "20001A");
+    }
+    f.build();
+    std::vector<std::string> patterns = {"starlink 1", "NOAA", "R B", "DEB ISS", "S", "ZZZ", "GPS BIIR", "12"};
+    std::vector<bool> hit;
+    auto got = f.index.matchAny(patterns, &hit);
+
+    std::vector<const CatalogEntry*> want;
+    std::vector<bool> want_hit(patterns.size(), false);
+    for (const auto& e : f.index.entries()) {
+        bool any = false;
+        for (size_t p = 0; p < patterns.size(); ++p) {
+            if (CatalogIndex::normalize(e.name).find(CatalogIndex::normalize(patterns[p])) != std::string::npos) {
+                any = true;
+                want_hit[p] = true;
+            }
+        }
+        if (any) want.push_back(&e);
+    }
+    bool ok = got == want && hit == want_hit && !hit[5] && hit[4];
+    std::cout << "Test 3 (Aho-Corasick vs per-pattern scan): " << got.size() << " matches, " << ok << " (Expected 1)" << std::endl;
+    assert(ok);
+}
+
+int main() {
+    test_normalize_and_keys();
+    test_search_order();
+    test_match_any_vs_scan();
+    std::cout << "ALL TESTS PASSED" << std::endl;
+    return 0;
+}
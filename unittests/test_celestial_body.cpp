@@ -0,0 +1,60 @@
+#include <iostream>
+#include <cassert>
+#include <cmath>
+#include "../include/celestial_body.hpp"
+
+using namespace ve;
+
+// Standalone: g++ -std=c++17 -I../include test_celestial_body.cpp ../src/celestial_body.cpp ../src/visibility.cpp
+
+void test_moon_meeus() {
+    // Meeus, Astronomical Algorithms, example 47.a: 1992 April 12, 0h TD
+    // RA 134.688470 deg, Dec 13.768368 deg, distance 368409.7 km
+    Vector3 m = CelestialBody::moonPositionEci(JulianTime{2448724.5, 0.0});
+    double dist = m.magnitude();
+    double ra = std::atan2(m.y, m.x) * RAD2DEG;
+    if (ra < 0.0) ra += 360.0;
+    double dec = std::asin(m.z / dist) * RAD2DEG;
+    bool ok = std::abs(ra - 134.688) < 0.5 && std::abs(dec - 13.768) < 0.5 && std::abs(dist - 368409.7) < 0.01 * 368409.7;
+    std::cout << "Test 1 (Moon vs Meeus 47.a, RA " << ra << " Dec " << dec << " dist " << dist << "): "
+              << ok << " (Expected 1)" << std::endl;
+    assert(ok);
+}
+
+void test_moon_orbit() {
+    // Over a month the distance stays within perigee/apogee bounds and the
+    // direction completes one sidereal revolution (27.32 days)
+    bool ok = true;
+    double prev_ra = 0.0, turned = 0.0;
+    for (int h = 0; h <= 24 * 28; h += 6) {
+        Vector3 m = CelestialBody::moonPositionEci(JulianTime{2460676.5 + h / 24.0, 0.0});
+        double d = m.magnitude();
+        ok = ok && d > 356000.0 && d < 407000.0;
+        double ra = std::atan2(m.y, m.x);
+        if (h == 0) prev_ra = ra;
+        double step = ra - prev_ra;
+        if (step < -PI) step += 2.0 * PI;
+        turned += step;
+        prev_ra = ra;
+    }
+    ok = ok && turned > 2.0 * PI && turned < 2.0 * PI * 28.0 / 27.0;
+    std::cout << "Test 2 (Distance bounds, one revolution per sidereal month): " << ok << " (Expected 1)" << std::endl;
+    assert(ok);
+}
+
+void test_selection() {
+    auto bodies = CelestialBody::fromSelection("ISS, moon,SUN ,Moon,HST");
+    bool ok = bodies.size() == 2 && bodies[0].kind() == CelestialBody::Kind::MOON && bodies[1].kind() == CelestialBody::Kind::SUN &&
+              bodies[0].getNoradId() == CelestialBody::MOON_ID && bodies[1].getNoradId() == CelestialBody::SUN_ID &&
+              CelestialBody::fromSelection("ISS,SUNSAT").empty();
+    std::cout << "Test 3 (Bodies picked from --satsel): " << ok << " (Expected 1)" << std::endl;
+    assert(ok);
+}
+
+int main() {
+    test_moon_meeus();
+    test_moon_orbit();
+    test_selection();
+    std::cout << "ALL TESTS PASSED" << std::endl;
+    return 0;
+}
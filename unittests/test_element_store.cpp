@@ -0,0 +1,69 @@
+#include <iostream>
+#include <cassert>
+#include <string>
+#include <vector>
+#include <cstdint>
+#include "../include/element_store.hpp"
+
+using namespace ve;
+
+// Standalone: g++ -std=c++17 -I../include test_element_store.cpp ../src/element_store.cpp
+
+const char* L1 = "1 25544U 98067A   08264.51782528 -.00002182  00000-0 -11606-4 0  2927";
+const char* L2 = "2 25544  51.6416 247.4627 0006703 130.5360 325.0288 15.72125391563537";
+
+void test_layout() {
+    ElementStore store(3);
+    bool ok = sizeof(ElementRecord) % 64 == 0 && alignof(ElementRecord) == 64;
+    for (size_t i = 0; i < store.size(); ++i) {
+        ok = ok && reinterpret_cast<uintptr_t>(&store.record(i)) % 64 == 0;
+    }
+    std::cout << "Test 1 (Records tile aligned cache lines, " << sizeof(ElementRecord) << " bytes): "
+              << ok << " (Expected 1)" << std::endl;
+    assert(ok);
+}
+
+void test_text() {
+    // Enough text to spill across several blocks; earlier views must stay valid
+    const size_t n = 3 * ElementStore::BLOCK_SIZE / 140;
+    ElementStore store(n);
+    std::vector<std::string> names;
+    for (size_t i = 0; i < n; ++i) {
+        names.push_back(i % 2 ? "FENGYUN 1C DEB" : "OBJECT " + std::to_string(i));
+        std::string l1 = L1, l2 = L2;
+        l1[2] = static_cast<char>('0' + i % 10);
+        store.setText(i, names.back(), l1, l2);
+    }
+    bool ok = true;
+    for (size_t i = 0; i < n; ++i) {
+        ok = ok && store.name(i) == names[i] && store.line1(i)[2] == static_cast<char>('0' + i % 10) &&
+             store.line1(i).substr(3) == std::string(L1).substr(3) && store.line2(i) == L2;
+    }
+    // Shared names are stored once
+    ok = ok && store.name(1).data() == store.name(3).data() && store.name(0).data() != store.name(2).data();
+    std::cout << "Test 2 (Text arena across blocks, interned names): " << ok << " (Expected 1)" << std::endl;
+    assert(ok);
+}
+
+void test_orbit() {
+    // ISS: ~15.72 rev/day, near-circular at ~350 km in 2008
+    ElementRecord r;
+    r.elements.mean_motion = 15.72125391 * SGP4_TWOPI / SGP4_MINUTES_PER_DAY;
+    r.elements.eccentricity = 0.0006703;
+    r.deriveOrbit();
+    bool ok = r.period_min > 91.5 && r.period_min < 91.7 && r.apogee_km > r.perigee_km &&
+              r.perigee_km > 330.0 && r.apogee_km < 370.0;
+    ElementRecord bad;
+    bad.deriveOrbit();
+    ok = ok && bad.apogee_km == 0.0 && bad.period_min == 0.0;
+    std::cout << "Test 3 (Derived apogee, perigee, period): " << ok << " (Expected 1)" << std::endl;
+    assert(ok);
+}
+
+int main() {
+    test_layout();
+    test_text();
+    test_orbit();
+    std::cout << "ALL TESTS PASSED" << std::endl;
+    return 0;
+}
@@ -0,0 +1,111 @@
+#include <iostream>
+#include <cassert>
+#include <cmath>
+#include <cstring>
+#include "../include/ephemeris.hpp"
+#include "../include/sgp4_kernel.hpp"
+
+using namespace ve;
+
+// Standalone: g++ -std=c++17 -I../include test_ephemeris.cpp ../src/ephemeris.cpp ../src/sgp4_kernel.cpp
+
+Sgp4NearEarth vallado00005() {
+    const double d2r = PI / 180.0;
+    Sgp4Elements el = {2451543.5 + 179.78495062, 34.2682 * d2r, 348.7242 * d2r, 0.1859667,
+                       331.7664 * d2r, 19.3264 * d2r, 10.82419157 * SGP4_TWOPI / SGP4_MINUTES_PER_DAY, 0.28098e-4};
+    Sgp4NearEarth c;
+    initSgp4(el, c);
+    return c;
+}
+
+void test_fit_matches_sgp4() {
+    // Eccentric (e = 0.19) LEO over 24h: exercises the perigee halving
+    Sgp4NearEarth c = vallado00005();
+    ChebyshevEphemeris::Sampler sample = [&c](double t, Vector3& pos, Vector3& vel) {
+        return propagateNearEarth(c, t, pos.x, pos.y, pos.z, vel.x, vel.y, vel.z) == SGP4_OK;
+    };
+    const double tol = 0.05;
+    ChebyshevEphemeris eph;
+    bool built = eph.build(sample, 0.0, 1440.0, 1440.0 / 10.82419157, tol);
+    assert(built);
+    assert(eph.covers(0.0) && eph.covers(1439.9) && !eph.covers(1440.0));
+
+    // Dense check at points the fitter never sampled
+    double worst_pos = 0.0, worst_vel = 0.0;
+    for (double t = 0.0; t < 1440.0; t += 0.37) {
+        Vector3 ref_pos, ref_vel, pos, vel;
+        sample(t, ref_pos, ref_vel);
+        bool hit = eph.evaluate(t, pos, vel);
+        assert(hit);
+        worst_pos = std::max(worst_pos, (pos - ref_pos).magnitude());
+        worst_vel = std::max(worst_vel, (vel - ref_vel).magnitude());
+    }
+    std::cout << "Test 1 (Fit vs SGP4): " << eph.segmentCount() << " segments, max err "
+              << worst_pos * 1000.0 << " m, " << worst_vel * 1000.0 << " m/s" << std::endl;
+    assert(worst_pos < tol);
+    assert(worst_vel < 0.005);
+}
+
+void test_out_of_range() {
+    Sgp4NearEarth c = vallado00005();
+    ChebyshevEphemeris::Sampler sample = [&c](double t, Vector3& pos, Vector3& vel) {
+        return propagateNearEarth(c, t, pos.x, pos.y, pos.z, vel.x, vel.y, vel.z) == SGP4_OK;
+    };
+    ChebyshevEphemeris eph;
+    bool built = eph.build(sample, 100.0, 200.0, 133.0, 0.05);
+    assert(built);
+    Vector3 pos, vel;
+    bool before = eph.evaluate(99.0, pos, vel);
+    bool after = eph.evaluate(200.5, pos, vel);
+    std::cout << "Test 2 (Out of Range): " << before << after << " (Expected 00)" << std::endl;
+    assert(!before && !after);
+}
+
+void test_sampler_failure_truncates() {
+    // A sampler that fails after t = 300 (e.g. decay) ends coverage at the last good segment
+    Sgp4NearEarth c = vallado00005();
+    ChebyshevEphemeris::Sampler sample = [&c](double t, Vector3& pos, Vector3& vel) {
+        if (t > 300.0) return false;
+        return propagateNearEarth(c, t, pos.x, pos.y, pos.z, vel.x, vel.y, vel.z) == SGP4_OK;
+    };
+    ChebyshevEphemeris eph;
+    bool built = eph.build(sample, 0.0, 1440.0, 133.0, 0.05);
+    assert(built);
+    std::cout << "Test 3 (Truncated): covers to " << eph.endMinutes() << " min" << std::endl;
+    assert(eph.endMinutes() <= 300.0);
+    assert(!eph.covers(400.0));
+}
+
+void test_assign_round_trip() {
+    // Segments copied out as raw bytes (as the pass cache stores them) evaluate identically
+    Sgp4NearEarth c = vallado00005();
+    ChebyshevEphemeris::Sampler sample = [&c](double t, Vector3& pos, Vector3& vel) {
+        return propagateNearEarth(c, t, pos.x, pos.y, pos.z, vel.x, vel.y, vel.z) == SGP4_OK;
+    };
+    ChebyshevEphemeris eph;
+    bool built = eph.build(sample, 0.0, 720.0, 133.0, 0.05);
+    assert(built);
+    std::vector<ChebyshevEphemeris::Segment> raw(eph.segmentCount());
+    std::memcpy(raw.data(), eph.segments().data(), raw.size() * sizeof(ChebyshevEphemeris::Segment));
+
+    ChebyshevEphemeris copy;
+    bool ok = copy.assign(raw, eph.maxErrorKm()) && copy.beginMinutes() == eph.beginMinutes() && copy.endMinutes() == eph.endMinutes();
+    for (double t = 0.0; ok && t < 720.0; t += 1.3) {
+        Vector3 p1, v1, p2, v2;
+        ok = eph.evaluate(t, p1, v1) && copy.evaluate(t, p2, v2) && p1.x == p2.x && p1.y == p2.y && p1.z == p2.z && v1.x == v2.x;
+    }
+    // A gap between segments is rejected
+    raw.erase(raw.begin() + 1);
+    bool gap_rejected = !ChebyshevEphemeris().assign(raw, 0.0);
+    std::cout << "Test 4 (Assign round trip): " << ok << gap_rejected << " (Expected 11)" << std::endl;
+    assert(ok && gap_rejected);
+}
+
+int main() {
+    test_fit_matches_sgp4();
+    test_out_of_range();
+    test_sampler_failure_truncates();
+    test_assign_round_trip();
+    std::cout << "ALL TESTS PASSED" << std::endl;
+    return 0;
+}
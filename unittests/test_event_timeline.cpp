@@ -0,0 +1,116 @@
+#include <iostream>
+#include <cassert>
+#include <vector>
+#include <random>
+#include <algorithm>
+#include "../include/event_timeline.hpp"
+
+using namespace ve;
+
+// Standalone: g++ -std=c++17 -I../include test_event_timeline.cpp ../src/event_timeline.cpp
+
+using Pass = EventTimeline::Pass;
+
+// Random catalog: 500 satellites, passes of 2-20 minutes (a few clipped ALWAYS-style
+// records of a full day) spread over 24h
+std::vector<Pass> makePasses(TimePoint t0) {
+    std::mt19937 rng(11);
+    std::uniform_int_distribution<int> start(0, 86400), len(120, 1200), sat(0, 499);
+    std::uniform_real_distribution<double> el(0.0, 90.0);
+    std::vector<Pass> passes;
+    for (int i = 0; i < 3000; ++i) {
+        int s = sat(rng);
+        TimePoint aos = t0 + std::chrono::seconds(start(rng));
+        TimePoint los = aos + std::chrono::seconds(len(rng));
+        passes.push_back({40000 + s, static_cast<uint32_t>(s), aos, aos + (los - aos) / 2, los, el(rng), 0, 0, 0, true, true});
+    }
+    for (int s = 0; s < 5; ++s) {
+        passes.push_back({40000 + s, static_cast<uint32_t>(s), t0, t0 + std::chrono::hours(12), t0 + std::chrono::hours(24), 40.0, 0, 0, 0, false, false});
+    }
+    return passes;
+}
+
+std::vector<std::string> makeNames() {
+    std::vector<std::string> names;
+    for (int s = 0; s < 500; ++s) names.push_back("SAT " + std::to_string(s));
+    return names;
+}
+
+// Reference: linear scan, AOS order with the same tie-break
+std::vector<Pass> reference(std::vector<Pass> all, const TimePoint& from, const TimePoint& to, double min_el) {
+    std::vector<Pass> out;
+    for (const auto& p : all) if (p.aos <= to && p.los >= from && p.max_el >= min_el) out.push_back(p);
+    std::sort(out.begin(), out.end(), [](const Pass& a, const Pass& b) {
+        return (a.aos != b.aos) ? a.aos < b.aos : a.norad_id < b.norad_id;
+    });
+    return out;
+}
+
+bool same(const std::vector<const Pass*>& got, const std::vector<Pass>& want) {
+    if (got.size() != want.size()) return false;
+    for (size_t i = 0; i < got.size(); ++i) {
+        if (got[i]->aos != want[i].aos || got[i]->los != want[i].los || got[i]->norad_id != want[i].norad_id) return false;
+    }
+    return true;
+}
+
+void test_window_queries() {
+    TimePoint t0 = Clock::now();
+    auto all = makePasses(t0);
+    EventTimeline tl(all, makeNames());
+    std::mt19937 rng(5);
+    std::uniform_int_distribution<int> at(-3600, 90000), width(0, 7200);
+    std::uniform_real_distribution<double> el(0.0, 60.0);
+    bool ok = tl.size() == all.size();
+    for (int i = 0; i < 2000 && ok; ++i) {
+        TimePoint from = t0 + std::chrono::seconds(at(rng));
+        TimePoint to = from + std::chrono::seconds(width(rng));
+        double min_el = el(rng);
+        ok = same(tl.query(from, to, min_el), reference(all, from, to, min_el));
+    }
+    std::cout << "Test 1 (Window queries vs linear scan): " << ok << " (Expected 1)" << std::endl;
+    assert(ok);
+}
+
+void test_next_passes() {
+    // In progress first, then upcoming rises, both in AOS order
+    TimePoint t0 = Clock::now();
+    auto all = makePasses(t0);
+    EventTimeline tl(all, makeNames());
+    TimePoint t = t0 + std::chrono::hours(6);
+    auto got = tl.nextPasses(t, 50, 30.0);
+    auto want = reference(all, t, TimePoint::max(), 30.0);
+    want.resize(50);
+    bool ok = same(got, want) && got.front()->aos <= t && tl.name(*got.front()) == "SAT " + std::to_string(got.front()->sat);
+    std::cout << "Test 2 (Next 50 passes above 30 deg): " << ok << " (Expected 1)" << std::endl;
+    assert(ok);
+}
+
+void test_events_merged() {
+    // Clipped records contribute only their TCA; everything comes out time-ordered
+    TimePoint t0 = Clock::now();
+    auto all = makePasses(t0);
+    EventTimeline tl(all, makeNames());
+    TimePoint from = t0 + std::chrono::hours(11), to = t0 + std::chrono::hours(13);
+    auto ev = tl.events(from, to);
+    bool ok = !ev.empty();
+    size_t tca_of_clipped = 0;
+    for (size_t i = 0; i < ev.size() && ok; ++i) {
+        ok = ev[i].time >= from && ev[i].time <= to && (i == 0 || ev[i - 1].time <= ev[i].time);
+        if (!ev[i].pass->has_aos) {
+            ok = ok && ev[i].type == EventTimeline::EventType::TCA;
+            tca_of_clipped++;
+        }
+    }
+    ok = ok && tca_of_clipped == 5;
+    std::cout << "Test 3 (Merged AOS/TCA/LOS events): " << ok << " (Expected 1)" << std::endl;
+    assert(ok);
+}
+
+int main() {
+    test_window_queries();
+    test_next_passes();
+    test_events_merged();
+    std::cout << "ALL TESTS PASSED" << std::endl;
+    return 0;
+}
@@ -1,11 +1,33 @@
 #include <iostream>
 #include <cassert>
 #include <cmath>
+#include <vector>
 #include "../include/visibility.hpp"
 #include "../include/types.hpp"
 
 using namespace ve;
 
+// Standalone: g++ -std=c++17 -I../include test_flare.cpp ../src/visibility.cpp
+
+// Trig reference: the umbra and mirror tests written with asin/acos
+static VisibilityCalculator::State refState(const Vector3& sat, const Vector3& obs, const Vector3& sun) {
+    double umbra = std::asin(EARTH_RADIUS_KM / sat.magnitude());
+    double angle = std::acos(sat.normalize().dot(sun.normalize()));
+    if (angle >= PI / 2.0 && (PI - angle) < umbra) return VisibilityCalculator::State::ECLIPSED;
+    double sun_el = (PI / 2.0) - std::acos(obs.normalize().dot(sun.normalize()));
+    return sun_el < (-6.0 * DEG2RAD) ? VisibilityCalculator::State::VISIBLE : VisibilityCalculator::State::DAYLIGHT;
+}
+
+static int refFlare(const Vector3& sat, const Vector3& obs, const Vector3& sun) {
+    Vector3 N = sat.normalize() * -1.0;
+    Vector3 I = (sat - sun).normalize();
+    if (I.dot(N) >= 0) return 0;
+    Vector3 R = I - (N * (2.0 * I.dot(N)));
+    double c = std::fmax(-1.0, std::fmin(1.0, R.normalize().dot((obs - sat).normalize())));
+    double deg = std::acos(c) * RAD2DEG;
+    return deg < 0.5 ? 2 : (deg < 1.0 ? 1 : 0);
+}
+
 void test_flare_visible() {
     // 1. Setup Perfect Geometry for Flare
     // Earth Center = 0,0,0
@@ -114,12 +136,75 @@ void test_daylight() {
     assert(res == 0);
 }
 
+void test_batch_states() {
+    // Ring of satellites in the sun-earth plane crossing the shadow, with the
+    // observer in daylight and at night
+    Vector3 sun = {149597870.7, 0, 0};
+    std::vector<double> px, py, pz;
+    for (int k = 0; k < 720; ++k) {
+        double a = k * 0.5 * DEG2RAD;
+        double r = 6800.0 + 30000.0 * (k % 3);
+        px.push_back(r * std::cos(a)); py.push_back(r * std::sin(a) * 0.8); pz.push_back(r * std::sin(a) * 0.6);
+    }
+    bool ok = true;
+    int eclipsed = 0;
+    for (Vector3 obs : {Vector3{6378, 0, 0}, Vector3{-6378, 0, 0}, Vector3{-800, 6300, 0}}) {
+        std::vector<VisibilityCalculator::State> out(px.size());
+        VisibilityCalculator::calculateStates(px.data(), py.data(), pz.data(), px.size(), obs, sun, out.data());
+        for (size_t i = 0; i < px.size(); ++i) {
+            Vector3 sat = {px[i], py[i], pz[i]};
+            ok = ok && out[i] == refState(sat, obs, sun);
+            eclipsed += out[i] == VisibilityCalculator::State::ECLIPSED;
+        }
+    }
+    ok = ok && eclipsed > 0;
+    std::cout << "Test 6 (Batch states match trig reference): " << ok << " (Expected 1)" << std::endl;
+    assert(ok);
+}
+
+void test_batch_flares() {
+    // Sun swept through the mirror cones of the nadir geometry, plus a
+    // high-apogee and a non-visible lane that must stay 0
+    Vector3 obs = {0, 0, 6378};
+    std::vector<double> px, py, pz, apogee;
+    std::vector<VisibilityCalculator::State> state;
+    for (int k = 0; k < 64; ++k) {
+        px.push_back(k * 2.0); py.push_back(-k * 1.5); pz.push_back(7000);
+        apogee.push_back(k == 5 ? 3622.0 : 622.0);
+        state.push_back(k == 6 ? VisibilityCalculator::State::ECLIPSED : VisibilityCalculator::State::VISIBLE);
+    }
+    bool ok = true;
+    int hits = 0, nears = 0;
+    for (double deg = 0.0; deg < 1.6; deg += 0.05) {
+        double ang = deg * DEG2RAD;
+        Vector3 sun = {150000000 * std::sin(ang), 0, -150000000 * std::cos(ang)};
+        std::vector<int8_t> out(px.size());
+        VisibilityCalculator::checkFlares(px.data(), py.data(), pz.data(), apogee.data(), state.data(), px.size(), obs, sun, out.data());
+        for (size_t i = 0; i < px.size(); ++i) {
+            Vector3 sat = {px[i], py[i], pz[i]};
+            int expect = (i == 5 || i == 6) ? 0 : refFlare(sat, obs, sun);
+            ok = ok && out[i] == expect && out[i] == (i == 6 ? 0 : VisibilityCalculator::checkFlare(sat, obs, sun, apogee[i]));
+            hits += out[i] == 2;
+            nears += out[i] == 1;
+        }
+    }
+    // Daylight gate clears the whole batch
+    std::vector<int8_t> day(px.size(), 7);
+    VisibilityCalculator::checkFlares(px.data(), py.data(), pz.data(), apogee.data(), state.data(), px.size(), obs, {0, 0, 150000000}, day.data());
+    for (int8_t f : day) ok = ok && f == 0;
+    ok = ok && hits > 0 && nears > 0;
+    std::cout << "Test 7 (Batch flares match trig reference): " << ok << " (Expected 1)" << std::endl;
+    assert(ok);
+}
+
 int main() {
     test_flare_visible();
     test_flare_miss();
     test_flare_near();
     test_not_leo();
     test_daylight();
+    test_batch_states();
+    test_batch_flares();
     std::cout << "ALL TESTS PASSED" << std::endl;
     return 0;
 }
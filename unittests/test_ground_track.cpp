@@ -0,0 +1,118 @@
+#include <iostream>
+#include <cassert>
+#include <cmath>
+#include <vector>
+#include "../include/ground_track.hpp"
+
+using namespace ve;
+
+// Standalone: g++ -std=c++17 -I../include test_ground_track.cpp ../src/ground_track.cpp
+
+static const TimePoint START = Clock::from_time_t(1221912000);     // 2008-09-20 12:00:00 UTC
+static const int HALF_WIDTH_MINS = 30;
+static const int MAX_STEP_SECS = 120;
+
+static double secs(const TimePoint& t) { return std::chrono::duration<double>(t - START).count(); }
+
+// Circular orbit under a rotating Earth; the sample time rides in alt_km so the
+// test can read back when each point was taken
+static GroundTrack::Sampler orbit(double incl_deg, double period_min) {
+    return [=](const TimePoint& t, Geodetic& g) {
+        double s = secs(t);
+        double u = 2.0 * PI * s / (period_min * 60.0);
+        double i = incl_deg * DEG2RAD;
+        double lon = std::atan2(std::sin(u) * std::cos(i), std::cos(u)) * RAD2DEG - 360.0 * s / 86164.1;
+        g.lat_deg = std::asin(std::sin(u) * std::sin(i)) * RAD2DEG;
+        g.lon_deg = std::remainder(lon, 360.0);
+        g.alt_km = s;
+        return true;
+    };
+}
+
+static bool same(const std::vector<Geodetic>& a, const std::vector<Geodetic>& b) {
+    if (a.size() != b.size()) return false;
+    for (size_t i = 0; i < a.size(); ++i) {
+        if (a[i].lat_deg != b[i].lat_deg || a[i].lon_deg != b[i].lon_deg || a[i].alt_km != b[i].alt_km) return false;
+    }
+    return true;
+}
+
+static GroundTrack fresh(const TimePoint& now, const GroundTrack::Sampler& sample) {
+    GroundTrack track;
+    track.reset(now, HALF_WIDTH_MINS, MAX_STEP_SECS, sample);
+    return track;
+}
+
+void test_advance_steps() {
+    // Equatorial LEO moves at a constant map rate, so the step is constant and
+    // sliding by whole steps lands on the grid a fresh window would sample
+    auto sample = orbit(0.0, 95.0);
+    GroundTrack track = fresh(START, sample);
+    auto before = track.copy();
+    bool ok = before.size() >= 3;
+    double step = ok ? before[1].alt_km - before[0].alt_km : 0.0;
+    ok = ok && step > GroundTrack::MIN_STEP_SECS && step < MAX_STEP_SECS;
+    for (size_t i = 1; ok && i < before.size(); ++i) ok = before[i].alt_km - before[i - 1].alt_km == step;
+
+    // One step: the oldest point expires, one new point is appended
+    TimePoint now = START + std::chrono::seconds(static_cast<long>(step));
+    track.advance(now, sample);
+    auto after = track.copy();
+    ok = ok && after.size() == before.size() && after.front().alt_km == before[1].alt_km &&
+         after[after.size() - 2].alt_km == before.back().alt_km && after.back().alt_km == before.back().alt_km + step;
+    ok = ok && same(after, fresh(now, sample).copy());
+    std::cout << "Test 1 (Advance by one step, " << step << " s): " << ok << " (Expected 1)" << std::endl;
+    assert(ok);
+
+    // Several steps at once
+    now += std::chrono::seconds(static_cast<long>(5 * step));
+    track.advance(now, sample);
+    ok = same(track.copy(), fresh(now, sample).copy()) && track.copy().front().alt_km == secs(now) - HALF_WIDTH_MINS * 60.0;
+    std::cout << "Test 2 (Advance by five steps equals a fresh reset): " << ok << " (Expected 1)" << std::endl;
+    assert(ok);
+}
+
+void test_jump() {
+    // Jumps past the window, forwards or backwards, rebuild it from scratch
+    auto sample = orbit(51.6, 92.0);
+    GroundTrack track = fresh(START, sample);
+    TimePoint later = START + std::chrono::minutes(HALF_WIDTH_MINS + 1) + std::chrono::seconds(7);
+    track.advance(later, sample);
+    bool ok = same(track.copy(), fresh(later, sample).copy());
+    track.advance(START, sample);
+    ok = ok && same(track.copy(), fresh(START, sample).copy());
+    std::cout << "Test 3 (Jump larger than the window rebuilds): " << ok << " (Expected 1)" << std::endl;
+    assert(ok);
+}
+
+void test_polar_steps() {
+    // Over the poles longitude swings fast: steps shrink there but stay in bounds,
+    // and each one covers about TARGET_STEP_DEG of map distance unless clamped
+    auto sample = orbit(89.0, 95.0);
+    GroundTrack track = fresh(START, sample);
+    double polar_max = 0.0, equator_min = 1e9;
+    bool ok = track.size() > 10;
+    for (int tick = 0; tick < 120 && ok; ++tick) {
+        track.advance(START + std::chrono::seconds(15 * tick), sample);
+        auto pts = track.copy();
+        for (size_t i = 1; ok && i < pts.size(); ++i) {
+            double dt = pts[i].alt_km - pts[i - 1].alt_km;
+            ok = dt >= GroundTrack::MIN_STEP_SECS && dt <= MAX_STEP_SECS;
+            double lat = std::abs(pts[i - 1].lat_deg);
+            if (lat > 85.0) polar_max = std::max(polar_max, dt);
+            if (lat < 10.0) equator_min = std::min(equator_min, dt);
+        }
+    }
+    ok = ok && polar_max > 0.0 && polar_max < equator_min;
+    std::cout << "Test 4 (Polar steps within [" << GroundTrack::MIN_STEP_SECS << ", " << MAX_STEP_SECS << "] s, "
+              << polar_max << " s at the pole vs " << equator_min << " s at the equator): " << ok << " (Expected 1)" << std::endl;
+    assert(ok);
+}
+
+int main() {
+    test_advance_steps();
+    test_jump();
+    test_polar_steps();
+    std::cout << "ALL TESTS PASSED" << std::endl;
+    return 0;
+}
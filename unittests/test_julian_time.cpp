@@ -0,0 +1,66 @@
+#include <iostream>
+#include <cassert>
+#include <cmath>
+#include "../include/types.hpp"
+
+using namespace ve;
+
+// Standalone: g++ -std=c++17 -I../include test_julian_time.cpp
+
+TimePoint utc(int64_t unix_sec, int64_t extra_us = 0) {
+    return TimePoint(std::chrono::seconds(unix_sec)) + std::chrono::microseconds(extra_us);
+}
+
+void test_j2000() {
+    // 2000-01-01 12:00:00 UTC = JD 2451545.0
+    JulianTime jt = JulianTime::fromTimePoint(utc(946728000));
+    std::cout << "Test 1 (J2000): day " << jt.day << " frac " << jt.frac << std::endl;
+    assert(jt.day == 2451544.5);
+    assert(jt.frac == 0.5);
+    assert(toJulianDate(utc(946728000)) == 2451545.0);
+}
+
+void test_gmst_j2000() {
+    // GMST at J2000.0 is 280.46061837 deg
+    double gmst_deg = JulianTime::fromTimePoint(utc(946728000)).gmst() * RAD2DEG;
+    std::cout << "Test 2 (GMST J2000): " << gmst_deg << " (Expected 280.46061837)" << std::endl;
+    assert(std::abs(gmst_deg - 280.46061837) < 1e-6);
+}
+
+void test_sub_second() {
+    // 250 ms must survive the conversion (the gmtime path truncated to seconds)
+    JulianTime a = JulianTime::fromTimePoint(utc(1700000000));
+    JulianTime b = JulianTime::fromTimePoint(utc(1700000000, 250000));
+    double dt_ms = b.minutesSince(a) * 60000.0;
+    std::cout << "Test 3 (Sub-second): " << dt_ms << " ms (Expected 250)" << std::endl;
+    assert(std::abs(dt_ms - 250.0) < 1e-3);
+}
+
+void test_ticks_epoch() {
+    // libsgp4 ticks count microseconds from 0001-01-01; both paths must agree
+    const int64_t ticks_to_unix = 62135596800LL * 1000000LL;
+    int64_t unix_us = 1700000000LL * 1000000LL + 123456;
+    JulianTime from_ticks = JulianTime::fromTicks(ticks_to_unix + unix_us);
+    JulianTime from_tp = JulianTime::fromTimePoint(utc(0, unix_us));
+    double diff_us = from_tp.minutesSince(from_ticks) * 60e6;
+    std::cout << "Test 4 (Ticks Epoch): " << diff_us << " us (Expected 0)" << std::endl;
+    assert(std::abs(diff_us) < 1.0);
+}
+
+void test_before_unix_epoch() {
+    // Negative offsets must still land on the previous 0h
+    JulianTime jt = JulianTime::fromTimePoint(utc(-1));
+    std::cout << "Test 5 (Pre-1970): day " << jt.day << std::endl;
+    assert(jt.day == JulianTime::UNIX_EPOCH_JD - 1.0);
+    assert(jt.frac > 0.99998 && jt.frac < 1.0);
+}
+
+int main() {
+    test_j2000();
+    test_gmst_j2000();
+    test_sub_second();
+    test_ticks_epoch();
+    test_before_unix_epoch();
+    std::cout << "ALL TESTS PASSED" << std::endl;
+    return 0;
+}
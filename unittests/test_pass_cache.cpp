@@ -0,0 +1,157 @@
+#include <iostream>
+#include <cassert>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <vector>
+#include "../include/pass_cache.hpp"
+#include "../include/pass_predictor.hpp"
+
+using namespace ve;
+
+// Standalone: g++ -std=c++17 -I../include test_pass_cache.cpp ../src/pass_cache.cpp ../src/pass_predictor.cpp
+//   ../src/satellite.cpp ../src/element_store.cpp ../src/sgp4_kernel.cpp ../src/observer.cpp ../src/reach.cpp
+//   ../src/ground_track.cpp ../src/ephemeris.cpp ../src/celestial_body.cpp ../src/visibility.cpp -lsgp4s
+
+static const char* ISS_1 = "1 25544U 98067A   08264.51782528 -.00002182  00000-0 -11606-4 0  2927";
+static const char* ISS_2 = "2 25544  51.6416 247.4627 0006703 130.5360 325.0288 15.72125391563537";
+// Same object, next element set number: a different TLE hash
+static const char* ISS_1B = "1 25544U 98067A   08264.51782528 -.00002182  00000-0 -11606-4 0  2938";
+static const char* GSO_1 = "1 99001U 08001A   08264.50000000  .00000000  00000-0  00000-0 0  9993";
+static const char* GSO_2 = "2 99001   8.0000  80.0000 0002000 270.0000  90.0000  1.00270000  1008";
+
+static const TimePoint START = Clock::from_time_t(1221912000);     // 2008-09-20 12:00:00 UTC
+static const char* PATH = "test_pass_cache.bin";
+static const int TRAIL_MINS = 5;
+
+static std::vector<char> readFile(const char* path) {
+    std::ifstream in(path, std::ios::binary);
+    return std::vector<char>(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+}
+
+static void writeFile(const char* path, const std::vector<char>& bytes) {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+}
+
+static bool sameRecords(const std::vector<Satellite::PassRecord>& a, const std::vector<Satellite::PassRecord>& b) {
+    if (a.size() != b.size()) return false;
+    for (size_t i = 0; i < a.size(); ++i) {
+        if (a[i].aos != b[i].aos || a[i].tca != b[i].tca || a[i].los != b[i].los || a[i].max_el != b[i].max_el ||
+            a[i].aos_az != b[i].aos_az || a[i].tca_az != b[i].tca_az || a[i].los_az != b[i].los_az ||
+            a[i].has_aos != b[i].has_aos || a[i].has_los != b[i].has_los) return false;
+    }
+    return true;
+}
+
+// Predictions and ephemeris for a day from START, as Precalc leaves them
+static void precompute(Satellite& sat, const Observer& obs, const AppConfig& cfg) {
+    PassPredictor predictor(obs);
+    auto fit_start = START - std::chrono::minutes(cfg.trail_length_mins);
+    sat.setEphemeris(sat.fitEphemeris(fit_start, 1440.0 + 2 * cfg.trail_length_mins, cfg.ephemeris_tolerance_km));
+    Reach reach = predictor.classify(sat, START, 1440, cfg.min_el);
+    sat.setReach(reach);
+    sat.setPassRecords(predictor.predictPasses(sat, START, 1440, reach), START + std::chrono::minutes(1440));
+}
+
+int main() {
+    Observer obs(40.0, -75.0, 0.0);
+    AppConfig cfg;
+    cfg.trail_length_mins = TRAIL_MINS;
+    PassCache::Key key = PassCache::makeKey(obs.getLocation(), cfg);
+
+    std::vector<Satellite> sats;
+    sats.emplace_back("ISS", ISS_1, ISS_2);
+    sats.emplace_back("GSO", GSO_1, GSO_2);
+    for (auto& sat : sats) precompute(sat, obs, cfg);
+    bool saved = PassCache::save(PATH, key, sats);
+    assert(saved);
+
+    // Test 1: save -> open -> restore gives back the records, reach, horizon and ephemeris
+    {
+        PassCache cache(PATH);
+        bool ok = cache.open(key);
+        const char* lines[2][2] = {{ISS_1, ISS_2}, {GSO_1, GSO_2}};
+        for (size_t i = 0; i < sats.size(); ++i) {
+            const Satellite& src = sats[i];
+            Satellite sat(src.getName(), lines[i][0], lines[i][1]);
+            ok = ok && cache.restore(sat, START, TRAIL_MINS) && sat.hasPredictions() &&
+                 sameRecords(sat.getPassRecords(), src.getPassRecords()) && sat.getReach() == src.getReach() &&
+                 sat.getPredictedUntil() == src.getPredictedUntil();
+            auto a = sat.getEphemeris(), b = src.getEphemeris();
+            ok = ok && a && b && a->segmentCount() == b->segmentCount() && a->maxErrorKm() == b->maxErrorKm() &&
+                 std::memcmp(a->segments().data(), b->segments().data(), a->segmentCount() * sizeof(ChebyshevEphemeris::Segment)) == 0;
+        }
+        std::cout << "Test 1 (Round trip, " << sats[0].getPassRecords().size() << " + " << sats[1].getPassRecords().size()
+                  << " passes): " << ok << " (Expected 1)" << std::endl;
+        assert(ok);
+    }
+
+    // Test 2: new elements for the same object miss
+    {
+        PassCache cache(PATH);
+        Satellite sat("ISS", ISS_1B, ISS_2);
+        bool ok = sat.getTleHash() != sats[0].getTleHash() && cache.open(key) && !cache.restore(sat, START, TRAIL_MINS) &&
+                  !sat.hasPredictions();
+        std::cout << "Test 2 (Different TLE hash misses): " << ok << " (Expected 1)" << std::endl;
+        assert(ok);
+    }
+
+    // Test 3: a cache built for another observer or min_el is rejected whole
+    {
+        PassCache cache(PATH);
+        PassCache::Key moved = key;
+        moved.lat += 0.001;
+        PassCache::Key higher = key;
+        higher.min_el = 10.0;
+        bool ok = !cache.open(moved) && !cache.open(higher) && !cache.isOpen() && cache.open(key);
+        std::cout << "Test 3 (Key mismatch rejected): " << ok << " (Expected 1)" << std::endl;
+        assert(ok);
+    }
+
+    // Test 4: truncated files, and counts that only add up once the products wrap
+    {
+        auto bytes = readFile(PATH);
+        PassCache cache(PATH);
+        bool ok = bytes.size() > 64;
+        std::vector<char> cut(bytes.begin(), bytes.end() - 8);
+        writeFile(PATH, cut);
+        ok = ok && !cache.open(key);
+        writeFile(PATH, std::vector<char>(bytes.begin(), bytes.begin() + 16));
+        ok = ok && !cache.open(key);
+
+        // entry_count sits after magic, version and the five key doubles; adding
+        // 2^64 / sizeof(Entry) leaves entry_count * sizeof(Entry) unchanged mod 2^64
+        std::vector<char> wrapped = bytes;
+        uint64_t count;
+        std::memcpy(&count, wrapped.data() + 48, sizeof(count));
+        count += uint64_t(1) << 58;
+        std::memcpy(wrapped.data() + 48, &count, sizeof(count));
+        writeFile(PATH, wrapped);
+        ok = ok && !cache.open(key);
+
+        writeFile(PATH, bytes);
+        ok = ok && cache.open(key);
+        std::cout << "Test 4 (Truncated or overflowing file rejected): " << ok << " (Expected 1)" << std::endl;
+        assert(ok);
+    }
+
+    // Test 5: an entry that no longer reaches MIN_AHEAD_MINS past now misses
+    {
+        PassCache cache(PATH);
+        TimePoint until = sats[0].getPredictedUntil();
+        TimePoint last_hit = until - std::chrono::minutes(PassCache::MIN_AHEAD_MINS);
+        Satellite hit("ISS", ISS_1, ISS_2), miss("ISS", ISS_1, ISS_2);
+        bool ok = cache.open(key) && cache.restore(hit, last_hit, TRAIL_MINS) &&
+                  !cache.restore(miss, last_hit + std::chrono::seconds(1), TRAIL_MINS) && !miss.hasPredictions();
+        // Passes that set before now are left out of a hit
+        for (const auto& p : hit.getPassRecords()) ok = ok && !(p.has_los && p.los < last_hit);
+        std::cout << "Test 5 (MIN_AHEAD_MINS expiry): " << ok << " (Expected 1)" << std::endl;
+        assert(ok);
+    }
+
+    std::remove(PATH);
+    std::cout << "ALL TESTS PASSED" << std::endl;
+    return 0;
+}
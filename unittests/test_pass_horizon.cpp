@@ -0,0 +1,107 @@
+#include <iostream>
+#include <cassert>
+#include <cmath>
+#include <vector>
+#include "../include/pass_horizon.hpp"
+#include "../include/pass_predictor.hpp"
+
+using namespace ve;
+
+// Standalone: g++ -std=c++17 -I../include test_pass_horizon.cpp ../src/pass_horizon.cpp ../src/pass_predictor.cpp
+//   ../src/satellite.cpp ../src/element_store.cpp ../src/sgp4_kernel.cpp ../src/observer.cpp ../src/reach.cpp
+//   ../src/ground_track.cpp ../src/ephemeris.cpp ../src/celestial_body.cpp ../src/visibility.cpp
+//   ../src/event_timeline.cpp -lsgp4s
+
+static const char* ISS_1 = "1 25544U 98067A   08264.51782528 -.00002182  00000-0 -11606-4 0  2927";
+static const char* ISS_2 = "2 25544  51.6416 247.4627 0006703 130.5360 325.0288 15.72125391563537";
+
+static const TimePoint START = Clock::from_time_t(1221912000);     // 2008-09-20 12:00:00 UTC
+
+static double secs(const TimePoint& t) { return std::chrono::duration<double>(t - START).count(); }
+static TimePoint at(double s) { return START + std::chrono::duration_cast<Clock::duration>(std::chrono::duration<double>(s)); }
+
+static Satellite::PassRecord record(double aos, double los, double max_el, bool has_aos, bool has_los) {
+    return {at(aos), at(0.5 * (aos + los)), at(los), max_el, 0.0, 0.0, 0.0, has_aos, has_los};
+}
+
+void test_straddling_pass() {
+    // Predictions end mid-pass; two rolling extensions must leave one record for
+    // it with the rise and set a single search over the whole span finds
+    Satellite iss("ISS", ISS_1, ISS_2);
+    Observer obs(40.0, -75.0, 0.0);
+    PassPredictor predictor(obs);
+    auto day = predictor.predictPasses(iss, START, 1440);
+    size_t k = 0;
+    while (k < day.size() && !(day[k].has_aos && day[k].has_los && secs(day[k].los) - secs(day[k].aos) >= 240.0)) ++k;
+    assert(k < day.size());
+    int seam_mins = static_cast<int>(std::floor(0.5 * (secs(day[k].aos) + secs(day[k].los)) / 60.0));
+    TimePoint seam = START + std::chrono::minutes(seam_mins);
+
+    iss.setPassRecords(predictor.predictPasses(iss, START, seam_mins), seam);
+    AppConfig cfg;
+    PassHorizon horizon;
+    TimePoint now = seam - std::chrono::minutes(PassHorizon::HORIZON_MINS - PassHorizon::CHUNK_MINS) + std::chrono::seconds(1);
+    std::vector<Satellite> sats;
+    sats.push_back(std::move(iss));
+    int extended = horizon.step(sats, obs, cfg, now, std::chrono::milliseconds(1000));
+    extended += horizon.step(sats, obs, cfg, now + std::chrono::minutes(PassHorizon::CHUNK_MINS), std::chrono::milliseconds(1000));
+
+    auto got = sats[0].getPassRecords();
+    auto ref = predictor.predictPasses(sats[0], START, seam_mins + 2 * PassHorizon::CHUNK_MINS);
+    bool ok = extended == 2 && sats[0].getPredictedUntil() == seam + std::chrono::minutes(2 * PassHorizon::CHUNK_MINS) &&
+              got.size() == ref.size();
+    int straddling = 0;
+    for (size_t i = 0; ok && i < got.size(); ++i) {
+        ok = got[i].has_aos == ref[i].has_aos && got[i].has_los == ref[i].has_los &&
+             std::abs(secs(got[i].aos) - secs(ref[i].aos)) < 1.0 && std::abs(secs(got[i].los) - secs(ref[i].los)) < 1.0 &&
+             std::abs(got[i].max_el - ref[i].max_el) < 0.01;
+        if (got[i].aos < seam && got[i].los > seam) straddling++;
+    }
+    ok = ok && straddling == 1;
+    std::cout << "Test 1 (Pass straddling the seam, " << got.size() << " records): " << ok << " (Expected 1)" << std::endl;
+    assert(ok);
+}
+
+void test_seam_disagreement() {
+    // The searches either side of the seam at 600 s disagree by a second or two
+    // on where the pass sets or rises
+    TimePoint seam = at(600.0);
+    auto run = [&](std::vector<Satellite::PassRecord> before, std::vector<Satellite::PassRecord> chunk) {
+        Satellite sat("ISS", ISS_1, ISS_2);
+        sat.setPassRecords(before, seam);
+        sat.extendPassRecords(chunk, at(4200.0), START);
+        return sat.getPassRecords();
+    };
+
+    // Old search saw the set just before the seam, new one starts still up
+    auto a = run({record(300.0, 598.0, 20.0, true, true)}, {record(600.0, 700.0, 1.0, false, true)});
+    bool ok = a.size() == 1 && a[0].has_aos && a[0].has_los && secs(a[0].aos) == 300.0 && secs(a[0].los) == 700.0 && a[0].max_el == 20.0;
+    std::cout << "Test 2 (Set just before the seam, open chunk pass): " << ok << " (Expected 1)" << std::endl;
+    assert(ok);
+
+    // Old search ended up, new one rises just after the seam
+    auto b = run({record(300.0, 600.0, 20.0, true, false)}, {record(601.0, 900.0, 35.0, true, true), record(3000.0, 3300.0, 10.0, true, true)});
+    ok = b.size() == 2 && secs(b[0].aos) == 300.0 && secs(b[0].los) == 900.0 && b[0].has_los && b[0].max_el == 35.0 &&
+         secs(b[1].aos) == 3000.0;
+    std::cout << "Test 3 (Open pass, rise just after the seam): " << ok << " (Expected 1)" << std::endl;
+    assert(ok);
+
+    // Old search ended up, new one starts below: the pass set at the seam
+    auto c = run({record(300.0, 600.0, 20.0, true, false)}, {record(3000.0, 3300.0, 10.0, true, true)});
+    ok = c.size() == 2 && c[0].has_los && secs(c[0].los) == 600.0 && secs(c[1].aos) == 3000.0;
+    std::cout << "Test 4 (Open pass, below the horizon after the seam): " << ok << " (Expected 1)" << std::endl;
+    assert(ok);
+
+    // Old search ended below, new one starts up: the pass rose at the seam
+    auto d = run({record(100.0, 200.0, 5.0, true, true)}, {record(600.0, 800.0, 12.0, false, true)});
+    ok = d.size() == 2 && d[1].has_aos && secs(d[1].aos) == 600.0 && secs(d[1].los) == 800.0;
+    std::cout << "Test 5 (Rise at the seam after an earlier set): " << ok << " (Expected 1)" << std::endl;
+    assert(ok);
+}
+
+int main() {
+    test_straddling_pass();
+    test_seam_disagreement();
+    std::cout << "ALL TESTS PASSED" << std::endl;
+    return 0;
+}
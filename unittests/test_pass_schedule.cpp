@@ -0,0 +1,88 @@
+#include <iostream>
+#include <cassert>
+#include <vector>
+#include <random>
+#include "../include/pass_schedule.hpp"
+
+using namespace ve;
+
+// Standalone: g++ -std=c++17 -I../include test_pass_schedule.cpp
+
+// Reference: the linear scan the satellite used before the cursor
+const PassSchedule::Event* reference(const std::vector<PassSchedule::Event>& ev, const TimePoint& t, bool aos_only) {
+    for (const auto& e : ev) {
+        if (e.time > t && (!aos_only || e.is_aos)) return &e;
+    }
+    return nullptr;
+}
+
+std::vector<PassSchedule::Event> makeEvents(TimePoint start, int passes) {
+    // Ten-minute passes every 95 minutes, AOS/LOS alternating
+    std::vector<PassSchedule::Event> ev;
+    for (int p = 0; p < passes; ++p) {
+        TimePoint aos = start + std::chrono::minutes(95 * p);
+        ev.push_back({aos, true});
+        ev.push_back({aos + std::chrono::minutes(10), false});
+    }
+    return ev;
+}
+
+bool same(const PassSchedule::Event* a, const PassSchedule::Event* b) {
+    if (!a || !b) return a == b;
+    return a->time == b->time && a->is_aos == b->is_aos;
+}
+
+void test_forward_ticks() {
+    TimePoint t0 = Clock::now();
+    auto ev = makeEvents(t0, 15);
+    PassSchedule s;
+    s.assign(ev);
+    bool ok = true;
+    for (int sec = -60; sec < 15 * 95 * 60 + 60; sec += 1) {
+        TimePoint t = t0 + std::chrono::seconds(sec);
+        ok = ok && same(s.next(t), reference(ev, t, false));
+    }
+    std::cout << "Test 1 (1 s ticks across 15 passes): " << ok << " (Expected 1)" << std::endl;
+    assert(ok);
+}
+
+void test_random_jumps() {
+    // Time warps backwards and far forwards must land where a fresh scan would
+    TimePoint t0 = Clock::now();
+    auto ev = makeEvents(t0, 40);
+    PassSchedule s;
+    s.assign(ev);
+    std::mt19937 rng(3);
+    std::uniform_int_distribution<int> dist(-3600, 40 * 95 * 60 + 3600);
+    bool ok = true;
+    for (int i = 0; i < 20000; ++i) {
+        TimePoint t = t0 + std::chrono::seconds(dist(rng));
+        ok = ok && same(s.next(t), reference(ev, t, false)) && same(s.nextAos(t), reference(ev, t, true));
+    }
+    std::cout << "Test 2 (Random jumps vs linear scan): " << ok << " (Expected 1)" << std::endl;
+    assert(ok);
+}
+
+void test_exact_and_reassign() {
+    // An event at exactly t is already past; reassigning resets the cursor
+    TimePoint t0 = Clock::now();
+    auto ev = makeEvents(t0, 3);
+    PassSchedule s;
+    s.assign(ev);
+    bool ok = same(s.next(t0), &ev[1]) && same(s.nextAos(t0), &ev[2]);
+    ok = ok && s.next(t0 + std::chrono::hours(24)) == nullptr;
+    s.assign(makeEvents(t0 + std::chrono::hours(1), 1));
+    ok = ok && s.size() == 2 && s.nextAos(t0) != nullptr && s.nextAos(t0)->time == t0 + std::chrono::hours(1);
+    s.clear();
+    ok = ok && s.next(t0) == nullptr;
+    std::cout << "Test 3 (Boundaries and reassign): " << ok << " (Expected 1)" << std::endl;
+    assert(ok);
+}
+
+int main() {
+    test_forward_ticks();
+    test_random_jumps();
+    test_exact_and_reassign();
+    std::cout << "ALL TESTS PASSED" << std::endl;
+    return 0;
+}
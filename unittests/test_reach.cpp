@@ -0,0 +1,77 @@
+#include <iostream>
+#include <cassert>
+#include <cmath>
+#include "../include/reach.hpp"
+
+using namespace ve;
+
+// Standalone: g++ -std=c++17 -I../include test_reach.cpp ../src/reach.cpp
+
+Sgp4Elements orbit(double incl_deg, double ecc, double revs_per_day) {
+    Sgp4Elements el = {};
+    el.epoch_jd = 2451545.0;
+    el.inclination = incl_deg * DEG2RAD;
+    el.eccentricity = ecc;
+    el.mean_motion = revs_per_day * SGP4_TWOPI / SGP4_MINUTES_PER_DAY;
+    return el;
+}
+
+void test_leo_latitude() {
+    // ISS-like: 51.6 deg, ~420 km. Coverage half-angle at 0 deg is ~20 deg.
+    Sgp4Elements iss = orbit(51.64, 0.0005, 15.5);
+    Reach mid = classifyReach(iss, {39.5, -76.1, 0.0}, 0.0, 1440.0, -40.0);
+    Reach edge = classifyReach(iss, {70.0, 20.0, 0.0}, 0.0, 1440.0, -40.0);
+    Reach polar = classifyReach(iss, {78.2, 15.6, 0.0}, 0.0, 1440.0, -40.0);
+    Reach masked = classifyReach(iss, {67.0, 20.0, 0.0}, 10.0, 1440.0, -40.0);
+    std::cout << "Test 1 (LEO latitude): " << reachName(mid) << " " << reachName(edge) << " "
+              << reachName(polar) << " " << reachName(masked) << " (Expected pass pass never never)" << std::endl;
+    assert(mid == Reach::PASS_CAPABLE);
+    assert(edge == Reach::PASS_CAPABLE);
+    assert(polar == Reach::NEVER);
+    assert(masked == Reach::NEVER);
+}
+
+void test_low_inclination() {
+    // Equatorial LEO never reaches a mid-latitude observer; retrograde mirrors prograde
+    Sgp4Elements eq = orbit(5.0, 0.001, 14.8);
+    Sgp4Elements retro = orbit(175.0, 0.001, 14.8);
+    Reach a = classifyReach(eq, {39.5, -76.1, 0.0}, 0.0, 1440.0, -60.0);
+    Reach b = classifyReach(retro, {-39.5, 150.0, 0.0}, 0.0, 1440.0, -60.0);
+    std::cout << "Test 2 (Low inclination): " << reachName(a) << " " << reachName(b) << " (Expected never never)" << std::endl;
+    assert(a == Reach::NEVER);
+    assert(b == Reach::NEVER);
+}
+
+void test_geo() {
+    // Station-kept GEO: parked above or below the horizon for the whole day
+    Sgp4Elements geo = orbit(0.05, 0.0002, 1.0027);
+    Reach up = classifyReach(geo, {39.5, -76.1, 0.0}, 0.0, 1440.0, 35.0);
+    Reach down = classifyReach(geo, {39.5, -76.1, 0.0}, 0.0, 1440.0, -30.0);
+    Reach grazing = classifyReach(geo, {39.5, -76.1, 0.0}, 0.0, 1440.0, 0.3);
+    // Drifting graveyard object: moves too far in a day to be called parked
+    Sgp4Elements drift = orbit(0.05, 0.0002, 0.95);
+    Reach d = classifyReach(drift, {39.5, -76.1, 0.0}, 0.0, 1440.0, 35.0);
+    std::cout << "Test 3 (GEO): " << reachName(up) << " " << reachName(down) << " " << reachName(grazing)
+              << " " << reachName(d) << " (Expected always never pass pass)" << std::endl;
+    assert(up == Reach::ALWAYS);
+    assert(down == Reach::NEVER);
+    assert(grazing == Reach::PASS_CAPABLE);
+    assert(d == Reach::PASS_CAPABLE);
+}
+
+void test_eccentric() {
+    // Molniya apogee covers the high north; perigee near the ground must not be called never
+    Sgp4Elements molniya = orbit(63.4, 0.72, 2.006);
+    Reach r = classifyReach(molniya, {-60.0, 0.0, 0.0}, 0.0, 1440.0, -10.0);
+    std::cout << "Test 4 (Molniya): " << reachName(r) << " (Expected pass)" << std::endl;
+    assert(r == Reach::PASS_CAPABLE);
+}
+
+int main() {
+    test_leo_latitude();
+    test_low_inclination();
+    test_geo();
+    test_eccentric();
+    std::cout << "ALL TESTS PASSED" << std::endl;
+    return 0;
+}
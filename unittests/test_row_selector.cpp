@@ -0,0 +1,72 @@
+#include <iostream>
+#include <cassert>
+#include <vector>
+#include <random>
+#include <cmath>
+#include "../include/row_selector.hpp"
+
+using namespace ve;
+
+// Standalone: g++ -std=c++17 -I../include test_row_selector.cpp ../src/row_selector.cpp
+
+// Reference: what the display loop used to do (stable sort, then truncate)
+std::vector<Candidate> reference(std::vector<Candidate> all, size_t k) {
+    std::stable_sort(all.begin(), all.end(), [](const Candidate& a, const Candidate& b) { return a.key < b.key; });
+    if (all.size() > k) all.resize(k);
+    return all;
+}
+
+void test_matches_stable_sort() {
+    // Coarse keys force plenty of ties; index order must decide them
+    std::mt19937 rng(42);
+    std::uniform_int_distribution<int> dist(-90, 90);
+    std::vector<Candidate> all;
+    for (size_t i = 0; i < 13000; ++i) all.push_back({static_cast<double>(dist(rng)), i});
+
+    for (size_t k : {1, 100, 5000, 20000}) {
+        TopK top(k);
+        for (const auto& c : all) top.offer(c);
+        auto got = top.takeSorted();
+        auto want = reference(all, k);
+        bool same = got.size() == want.size();
+        for (size_t i = 0; same && i < got.size(); ++i) same = (got[i].index == want[i].index);
+        std::cout << "Test 1 (Top " << k << " vs stable_sort): " << (same ? "match" : "MISMATCH") << std::endl;
+        assert(same);
+    }
+}
+
+void test_sharded_merge() {
+    // Per-shard selection then a merge must give the same answer as one pass
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<double> dist(0.0, 50.0);
+    std::vector<Candidate> all;
+    for (size_t i = 0; i < 4000; ++i) all.push_back({std::floor(dist(rng)), i});
+
+    const size_t k = 100;
+    std::vector<TopK> shards(7, TopK(k));
+    for (size_t i = 0; i < all.size(); ++i) shards[i * shards.size() / all.size()].offer(all[i]);
+    TopK merged(k);
+    for (const auto& s : shards) for (const auto& c : s.items()) merged.offer(c);
+    auto got = merged.takeSorted();
+    auto want = reference(all, k);
+    bool same = got.size() == want.size();
+    for (size_t i = 0; same && i < got.size(); ++i) same = (got[i].index == want[i].index);
+    std::cout << "Test 2 (Sharded merge): " << (same ? "match" : "MISMATCH") << std::endl;
+    assert(same);
+}
+
+void test_sort_key_names() {
+    bool ok = parseSortKey("range") == SortKey::RANGE && parseSortKey("aos") == SortKey::NEXT_AOS &&
+              parseSortKey("flare") == SortKey::FLARE && parseSortKey("bogus") == SortKey::ELEVATION &&
+              std::string(sortKeyName(parseSortKey("aos"))) == "aos";
+    std::cout << "Test 3 (Sort key names): " << ok << " (Expected 1)" << std::endl;
+    assert(ok);
+}
+
+int main() {
+    test_matches_stable_sort();
+    test_sharded_merge();
+    test_sort_key_names();
+    std::cout << "ALL TESTS PASSED" << std::endl;
+    return 0;
+}
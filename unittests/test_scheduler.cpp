@@ -0,0 +1,117 @@
+#include <iostream>
+#include <cassert>
+#include <vector>
+#include <stdexcept>
+#include "../include/scheduler.hpp"
+
+using namespace ve;
+
+// Standalone: g++ -std=c++17 -pthread -I../include test_scheduler.cpp
+
+void test_coverage() {
+    // Every index runs exactly once, whatever the grain
+    Scheduler sched(4);
+    const size_t n = 13001;
+    for (size_t grain : {1, 7, 64, 20000}) {
+        std::vector<int> hits(n, 0);
+        sched.parallel_for(n, grain, [&](size_t b, size_t e) {
+            for (size_t i = b; i < e; ++i) hits[i]++;
+        });
+        size_t bad = 0;
+        for (int h : hits) if (h != 1) bad++;
+        std::cout << "Test 1 (Coverage, grain " << grain << "): " << bad << " bad (Expected 0)" << std::endl;
+        assert(bad == 0);
+    }
+}
+
+void test_uneven_load() {
+    // Heavy tail: the block dealt to the last worker must get stolen
+    Scheduler sched(3);
+    std::atomic<size_t> sum{0};
+    sched.parallel_for(300, 1, [&](size_t b, size_t e) {
+        for (size_t i = b; i < e; ++i) {
+            if (i >= 200) std::this_thread::sleep_for(std::chrono::microseconds(200));
+            sum += i;
+        }
+    });
+    std::cout << "Test 2 (Uneven load): sum " << sum.load() << " (Expected 44850)" << std::endl;
+    assert(sum.load() == 44850);
+}
+
+void test_progress_and_nesting() {
+    Scheduler sched(2);
+    size_t last = 0;
+    int reports = 0;
+    std::atomic<int> inner{0};
+    sched.parallel_for(40, 1, [&](size_t, size_t) {
+        std::this_thread::sleep_for(std::chrono::milliseconds(2));
+        // Nested call from a worker must not deadlock
+        sched.parallel_for(10, 3, [&](size_t b, size_t e) { inner += static_cast<int>(e - b); });
+    }, [&](size_t done) { assert(done >= last); last = done; reports++; }, std::chrono::milliseconds(5));
+    std::cout << "Test 3 (Progress/Nesting): last " << last << ", inner " << inner.load() << ", reports " << reports << " (Expected 40, 400)" << std::endl;
+    assert(last == 40);
+    assert(inner.load() == 400);
+}
+
+void test_exception() {
+    Scheduler sched(2);
+    bool caught = false;
+    try {
+        sched.parallel_for(100, 5, [](size_t b, size_t) { if (b == 50) throw std::runtime_error("chunk 50"); });
+    } catch (const std::runtime_error&) { caught = true; }
+    std::cout << "Test 4 (Exception): " << caught << " (Expected 1)" << std::endl;
+    assert(caught);
+}
+
+void test_submit() {
+    // A background loop runs alongside blocking loops and finishes on wait()
+    Scheduler pool(3);
+    std::atomic<int> background{0};
+    auto pending = pool.submit(200, 1, [&](size_t b, size_t e) {
+        for (size_t i = b; i < e; ++i) { std::this_thread::sleep_for(std::chrono::microseconds(200)); background++; }
+    });
+    std::atomic<int> ticks{0};
+    for (int t = 0; t < 10; ++t) pool.parallel_for(100, 10, [&](size_t b, size_t e) { ticks += static_cast<int>(e - b); });
+    pending->wait();
+    bool ok = pending->done() && background.load() == 200 && ticks.load() == 1000;
+    std::cout << "Test 5 (Submit): background " << background.load() << ", ticks " << ticks.load() << " (Expected 200, 1000)" << std::endl;
+    assert(ok);
+}
+
+void test_submit_does_not_block_loops() {
+    // A tick-sized parallel_for returns within a few chunk-times while a long
+    // background loop is pending; the caller never drains background chunks
+    Scheduler pool(3);
+    std::atomic<bool> stop{false};
+    std::atomic<int> background{0};
+    auto pending = pool.submit(2000, 1, [&](size_t b, size_t e) {
+        for (size_t i = b; i < e; ++i) {
+            if (stop) return;
+            std::this_thread::sleep_for(std::chrono::milliseconds(5));
+            background++;
+        }
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    std::atomic<int> ticks{0};
+    auto t0 = std::chrono::steady_clock::now();
+    pool.parallel_for(1000, 64, [&](size_t b, size_t e) { ticks += static_cast<int>(e - b); });
+    double ms = std::chrono::duration<double, std::milli>(std::chrono::steady_clock::now() - t0).count();
+    int during = background.load();
+    stop = true;
+    pending->wait();
+    bool ok = ticks.load() == 1000 && ms < 50.0 && during < 200;
+    std::cout << "Test 6 (Loop beside background work): " << ms << " ms, background " << during
+              << "/2000 (Expected < 50 ms, < 200)" << std::endl;
+    assert(ok);
+}
+
+int main() {
+    test_coverage();
+    test_uneven_load();
+    test_progress_and_nesting();
+    test_exception();
+    test_submit();
+    test_submit_does_not_block_loops();
+    std::cout << "ALL TESTS PASSED" << std::endl;
+    return 0;
+}
@@ -0,0 +1,78 @@
+#include <iostream>
+#include <cassert>
+#include <cmath>
+#include "../include/sgp4_kernel.hpp"
+
+using namespace ve;
+
+// Standalone: g++ -std=c++17 -I../include test_sgp4_kernel.cpp ../src/sgp4_kernel.cpp
+
+void test_sincos() {
+    // Polynomial sin/cos must track libm across the angle range seen by SGP4
+    double worst = 0.0;
+    for (double x = -2000.0; x <= 2000.0; x += 0.0137) {
+        double s, c;
+        sincosKernel(x, s, c);
+        worst = std::max(worst, std::fabs(s - std::sin(x)));
+        worst = std::max(worst, std::fabs(c - std::cos(x)));
+    }
+    std::cout << "Test 1 (sincosKernel): max error " << worst << std::endl;
+    assert(worst < 1e-14);
+}
+
+void test_vallado_00005() {
+    // Vallado "Revisiting Spacetrack Report #3", catalog 00005
+    // 1 00005U 58002B   00179.78495062  .00000023  00000-0  28098-4 0  4753
+    // 2 00005  34.2682 348.7242 1859667 331.7664  19.3264 10.82419157413667
+    const double d2r = M_PI / 180.0;
+    Sgp4Elements el;
+    el.epoch_jd = 2451543.5 + 179.78495062;
+    el.inclination = 34.2682 * d2r;
+    el.raan = 348.7242 * d2r;
+    el.eccentricity = 0.1859667;
+    el.arg_perigee = 331.7664 * d2r;
+    el.mean_anomaly = 19.3264 * d2r;
+    el.mean_motion = 10.82419157 * SGP4_TWOPI / SGP4_MINUTES_PER_DAY;
+    el.bstar = 0.28098e-4;
+
+    Sgp4NearEarth c;
+    Sgp4Model model = initSgp4(el, c);
+    assert(model == Sgp4Model::NEAR_EARTH);
+
+    struct Ref { double t, x, y, z, vx, vy, vz; };
+    const Ref refs[] = {
+        {   0.0,  7022.46529266, -1400.08296755,     0.03995155,  1.893841015,  6.405893759,  4.534807250},
+        { 360.0, -7154.03120202, -3783.17682504, -3536.19412294,  4.741887409, -4.151817765, -2.093935425},
+        { 720.0, -7134.59340119,  6531.68641334,  3260.27186483, -4.113793027, -2.911922039, -2.557327851},
+        {1080.0,  5568.53901181,  4492.06992591,  3863.87641983, -4.209106476,  5.159719888,  2.744852980},
+        {1440.0,  -938.55923943, -6268.18748831, -4294.02924751,  7.536105209, -0.427127707,  0.989878080},
+    };
+    for (const auto& r : refs) {
+        double x, y, z, vx, vy, vz;
+        uint8_t status = propagateNearEarth(c, r.t, x, y, z, vx, vy, vz);
+        double dp = std::sqrt((x - r.x) * (x - r.x) + (y - r.y) * (y - r.y) + (z - r.z) * (z - r.z));
+        double dv = std::sqrt((vx - r.vx) * (vx - r.vx) + (vy - r.vy) * (vy - r.vy) + (vz - r.vz) * (vz - r.vz));
+        std::cout << "Test 2 (00005 @ " << r.t << " min): dp " << dp << " km, dv " << dv << " km/s" << std::endl;
+        assert(status == SGP4_OK);
+        assert(dp < 1e-6);
+        assert(dv < 1e-8);
+    }
+}
+
+void test_deep_space_rejected() {
+    // 12h Molniya-like period must be left to libsgp4 (SDP4)
+    Sgp4Elements el = {2451545.0, 63.4 * M_PI / 180.0, 0.0, 0.7, 270.0 * M_PI / 180.0, 0.0,
+                       2.0 * SGP4_TWOPI / SGP4_MINUTES_PER_DAY, 0.0};
+    Sgp4NearEarth c;
+    Sgp4Model m = initSgp4(el, c);
+    std::cout << "Test 3 (Deep Space): " << static_cast<int>(m) << " (Expected 1)" << std::endl;
+    assert(m == Sgp4Model::DEEP_SPACE);
+}
+
+int main() {
+    test_sincos();
+    test_vallado_00005();
+    test_deep_space_rejected();
+    std::cout << "ALL TESTS PASSED" << std::endl;
+    return 0;
+}
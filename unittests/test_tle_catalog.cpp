@@ -0,0 +1,134 @@
+#include <iostream>
+#include <cassert>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+#include <filesystem>
+#include <unistd.h>
+#include "../include/tle_catalog.hpp"
+#include "../include/satellite.hpp"
+
+using namespace ve;
+namespace fs = std::filesystem;
+
+// Standalone: g++ -std=c++17 -I../include test_tle_catalog.cpp ../src/tle_catalog.cpp ../src/element_store.cpp
+//   ../src/satellite.cpp ../src/sgp4_kernel.cpp ../src/observer.cpp ../src/reach.cpp ../src/ground_track.cpp
+//   ../src/ephemeris.cpp ../src/celestial_body.cpp ../src/visibility.cpp -lsgp4s
+
+static const char* TLES[][3] = {
+    {"ISS (ZARYA)", "1 25544U 98067A   08264.51782528 -.00002182  00000-0 -11606-4 0  2927",
+                    "2 25544  51.6416 247.4627 0006703 130.5360 325.0288 15.72125391563537"},
+    {"GSO TEST", "1 99001U 08001A   08264.50000000  .00000000  00000-0  00000-0 0  9993",
+                 "2 99001   8.0000  80.0000 0002000 270.0000  90.0000  1.00270000  1008"},
+};
+static const size_t COUNT = sizeof(TLES) / sizeof(TLES[0]);
+
+static std::vector<char> readFile(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    return std::vector<char>(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+}
+
+static void writeFile(const std::string& path, const std::vector<char>& bytes) {
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+}
+
+static void writeText(const std::string& path, size_t count) {
+    std::ofstream out(path, std::ios::trunc);
+    for (size_t i = 0; i < count; ++i) out << TLES[i][0] << "\n" << TLES[i][1] << "\n" << TLES[i][2] << "\n";
+}
+
+// Parsed and derived the way TleManager does on a catalog miss
+static std::shared_ptr<ElementStore> parse(size_t count) {
+    auto store = std::make_shared<ElementStore>(count);
+    for (size_t i = 0; i < count; ++i) {
+        store->setText(i, TLES[i][0], TLES[i][1], TLES[i][2]);
+        Satellite::deriveRecord(*store, i);
+    }
+    return store;
+}
+
+template<class T> static void patch(std::vector<char>& bytes, size_t offset, T value) {
+    std::memcpy(bytes.data() + offset, &value, sizeof(T));
+}
+template<class T> static T peek(const std::vector<char>& bytes, size_t offset) {
+    T value;
+    std::memcpy(&value, bytes.data() + offset, sizeof(T));
+    return value;
+}
+
+int main() {
+    fs::path root = fs::temp_directory_path() / ("ve_catalog_" + std::to_string(getpid()));
+    fs::create_directories(root);
+    std::string text = (root / "stations.txt").string();
+    std::string path = TleCatalog::pathFor(text);
+    writeText(text, COUNT);
+    auto fresh = parse(COUNT);
+    bool saved = TleCatalog::save(text, *fresh);
+    assert(saved);
+
+    // Test 1: every loaded record matches a fresh deriveRecord
+    {
+        TleCatalog catalog;
+        bool ok = catalog.open(text) && catalog.size() == COUNT;
+        auto loaded = ok ? catalog.load() : nullptr;
+        for (size_t i = 0; ok && i < COUNT; ++i) {
+            const ElementRecord& a = loaded->record(i);
+            const ElementRecord& b = fresh->record(i);
+            ok = a.norad_id == b.norad_id && a.model == b.model && a.tle_hash == b.tle_hash &&
+                 a.epoch.day == b.epoch.day && a.epoch.frac == b.epoch.frac &&
+                 std::memcmp(&a.elements, &b.elements, sizeof(Sgp4Elements)) == 0 &&
+                 std::memcmp(&a.near_earth, &b.near_earth, sizeof(Sgp4NearEarth)) == 0 &&
+                 a.apogee_km == b.apogee_km && a.perigee_km == b.perigee_km && a.period_min == b.period_min &&
+                 loaded->name(i) == fresh->name(i) && loaded->line1(i) == fresh->line1(i) && loaded->line2(i) == fresh->line2(i);
+        }
+        std::cout << "Test 1 (Round trip matches deriveRecord, " << COUNT << " records): " << ok << " (Expected 1)" << std::endl;
+        assert(ok);
+    }
+
+    // Test 2: rewriting the text makes the catalog stale, by size or by mtime alone
+    {
+        TleCatalog catalog;
+        auto stamp = fs::last_write_time(text);
+        writeText(text, 1);
+        bool ok = !catalog.open(text);
+        writeText(text, COUNT);
+        fs::last_write_time(text, stamp + std::chrono::seconds(10));
+        ok = ok && fs::file_size(text) > 0 && !catalog.open(text);
+        fs::last_write_time(text, stamp);
+        ok = ok && catalog.open(text);
+        std::cout << "Test 2 (Stale after the text changes): " << ok << " (Expected 1)" << std::endl;
+        assert(ok);
+    }
+
+    // Test 3: header fields that do not match this build are rejected. Layout:
+    // magic, version, record_size, reserved, source_size, source_mtime, record_count, text_size
+    {
+        TleCatalog catalog;
+        auto bytes = readFile(path);
+        bool ok = bytes.size() > 48;
+        auto version = bytes, record_size = bytes, truncated = bytes, wrapped = bytes;
+        patch<uint32_t>(version, 4, peek<uint32_t>(bytes, 4) + 1);
+        patch<uint32_t>(record_size, 8, peek<uint32_t>(bytes, 8) - 8);
+        truncated.resize(bytes.size() - 1);
+        // One more record and a text size short by one record: the sum still
+        // matches the file size modulo 2^64
+        uint32_t rsize = peek<uint32_t>(bytes, 8);
+        patch<uint64_t>(wrapped, 32, peek<uint64_t>(bytes, 32) + 1);
+        patch<uint64_t>(wrapped, 40, peek<uint64_t>(bytes, 40) - rsize);
+        for (const auto* corrupt : {&version, &record_size, &truncated, &wrapped}) {
+            writeFile(path, *corrupt);
+            ok = ok && !catalog.open(text);
+        }
+        writeFile(path, bytes);
+        ok = ok && catalog.open(text);
+        std::cout << "Test 3 (Wrong version, record size or counts rejected): " << ok << " (Expected 1)" << std::endl;
+        assert(ok);
+    }
+
+    fs::remove_all(root);
+    std::cout << "ALL TESTS PASSED" << std::endl;
+    return 0;
+}
@@ -0,0 +1,121 @@
+#include <iostream>
+#include <cassert>
+#include <cstdlib>
+#include <fstream>
+#include <sstream>
+#include <string>
+#include <thread>
+#include <vector>
+#include <filesystem>
+#include <unistd.h>
+#include "../include/tle_fetcher.hpp"
+
+using namespace ve;
+namespace fs = std::filesystem;
+
+// Standalone: g++ -std=c++17 -I../include test_tle_fetcher.cpp ../src/tle_fetcher.cpp ../src/logger.cpp -lcurl
+// Run from unittests/: it starts tle_mirror.py on a local port
+
+static const char* ISS =
+    "ISS (ZARYA)\n"
+    "1 25544U 98067A   08264.51782528 -.00002182  00000-0 -11606-4 0  2927\n"
+    "2 25544  51.6416 247.4627 0006703 130.5360 325.0288 15.72125391563537\n";
+static const char* GSO =
+    "GSO TEST\n"
+    "1 99001U 08001A   08264.50000000  .00000000  00000-0  00000-0 0  9993\n"
+    "2 99001   8.0000  80.0000 0002000 270.0000  90.0000  1.00270000  1008\n";
+
+static std::string readFile(const fs::path& p) {
+    std::ifstream in(p, std::ios::binary);
+    std::stringstream ss;
+    ss << in.rdbuf();
+    return ss.str();
+}
+
+static void writeFile(const fs::path& p, const std::string& s) {
+    std::ofstream out(p, std::ios::binary | std::ios::trunc);
+    out << s;
+}
+
+static std::string metaEtag(const fs::path& p) {
+    std::ifstream in(p.string() + ".meta");
+    std::string line;
+    while (std::getline(in, line)) if (line.rfind("etag: ", 0) == 0) return line.substr(6);
+    return "";
+}
+
+static bool noTempFiles(const fs::path& dir) {
+    for (const auto& e : fs::directory_iterator(dir)) if (e.path().extension() == ".tmp") return false;
+    return true;
+}
+
+int main() {
+    // 1. Fixtures and a mirror serving them
+    fs::path root = fs::temp_directory_path() / ("ve_fetch_" + std::to_string(getpid()));
+    fs::path fixtures = root / "fixtures", cache = root / "cache";
+    fs::create_directories(fixtures);
+    fs::create_directories(cache);
+    writeFile(fixtures / "stations.txt", ISS);
+    writeFile(fixtures / "weather.txt", GSO);
+    int port = 20000 + getpid() % 20000;
+    std::string cmd = "python3 tle_mirror.py --dir " + fixtures.string() + " --port " + std::to_string(port) +
+                      " >/dev/null 2>&1 & echo $! > " + (root / "mirror.pid").string();
+    int rc = std::system(cmd.c_str());
+    assert(rc == 0);
+
+    std::string base = "http://127.0.0.1:" + std::to_string(port);
+    auto url = [&](const std::string& group) { return base + "/gp.php?GROUP=" + group + "&FORMAT=tle"; };
+    std::vector<TleFetcher::Job> jobs = {{url("stations"), (cache / "stations.txt").string()},
+                                         {url("weather"), (cache / "weather.txt").string()}};
+    TleFetcher fetcher;
+
+    // Wait for the mirror to listen; nothing is written until a fetch succeeds
+    std::vector<TleFetcher::Result> r;
+    for (int i = 0; i < 100; ++i) {
+        r = fetcher.fetch(jobs);
+        if (r[0] != TleFetcher::Result::FAILED) break;
+        std::this_thread::sleep_for(std::chrono::milliseconds(100));
+    }
+
+    // Test 1: both groups download together, validators stored beside them
+    bool ok = r.size() == 2 && r[0] == TleFetcher::Result::UPDATED && r[1] == TleFetcher::Result::UPDATED &&
+              readFile(jobs[0].path) == ISS && readFile(jobs[1].path) == GSO &&
+              !metaEtag(jobs[0].path).empty() && TleFetcher::lastChecked(jobs[0].path) > 0 && noTempFiles(cache);
+    std::cout << "Test 1 (Concurrent download of two groups): " << ok << " (Expected 1)" << std::endl;
+    assert(ok);
+
+    // Test 2: a repeat is a conditional GET; the 304 only refreshes the .meta check time
+    auto mtime = fs::last_write_time(jobs[0].path);
+    std::time_t checked = TleFetcher::lastChecked(jobs[0].path);
+    std::this_thread::sleep_for(std::chrono::milliseconds(1100));
+    r = fetcher.fetch(jobs);
+    ok = r[0] == TleFetcher::Result::NOT_MODIFIED && r[1] == TleFetcher::Result::NOT_MODIFIED &&
+         fs::last_write_time(jobs[0].path) == mtime && readFile(jobs[0].path) == ISS &&
+         TleFetcher::lastChecked(jobs[0].path) > checked;
+    std::cout << "Test 2 (Unchanged groups answer 304, file untouched): " << ok << " (Expected 1)" << std::endl;
+    assert(ok);
+
+    // Test 3: a changed fixture is downloaded again and replaces the file whole
+    writeFile(fixtures / "stations.txt", std::string(ISS) + GSO);
+    r = fetcher.fetch(jobs);
+    ok = r[0] == TleFetcher::Result::UPDATED && r[1] == TleFetcher::Result::NOT_MODIFIED &&
+         readFile(jobs[0].path) == std::string(ISS) + GSO && noTempFiles(cache);
+    std::cout << "Test 3 (Changed fixture updated, other group 304): " << ok << " (Expected 1)" << std::endl;
+    assert(ok);
+
+    // Test 4: only the final response's validators are kept across a redirect,
+    // so the next conditional GET still matches
+    std::vector<TleFetcher::Job> redirected = {{base + "/redirect/gp.php?GROUP=weather&FORMAT=tle", (cache / "redirected.txt").string()}};
+    r = fetcher.fetch(redirected);
+    ok = r[0] == TleFetcher::Result::UPDATED && readFile(redirected[0].path) == GSO &&
+         metaEtag(redirected[0].path) == metaEtag(jobs[1].path);
+    r = fetcher.fetch(redirected);
+    ok = ok && r[0] == TleFetcher::Result::NOT_MODIFIED;
+    std::cout << "Test 4 (Validators reset on redirect): " << ok << " (Expected 1)" << std::endl;
+    assert(ok);
+
+    rc = std::system(("kill $(cat " + (root / "mirror.pid").string() + ")").c_str());
+    fs::remove_all(root);
+    std::cout << "ALL TESTS PASSED" << std::endl;
+    return 0;
+}
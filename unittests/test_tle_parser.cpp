@@ -0,0 +1,59 @@
+#include <iostream>
+#include <cassert>
+#include <string>
+#include "../include/tle_parser.hpp"
+
+using namespace ve;
+
+// Standalone: g++ -std=c++17 -I../include test_tle_parser.cpp ../src/tle_parser.cpp
+
+const std::string ISS_L1 = "1 25544U 98067A   08264.51782528 -.00002182  00000-0 -11606-4 0  2927";
+const std::string ISS_L2 = "2 25544  51.6416 247.4627 0006703 130.5360 325.0288 15.72125391563537";
+
+void test_checksum() {
+    std::string bad = ISS_L1;
+    bad[68] = '8';
+    bool ok = tleChecksumOk(ISS_L1) && tleChecksumOk(ISS_L2) && !tleChecksumOk(bad) && !tleChecksumOk("1 25544U");
+    std::cout << "Test 1 (Checksums): " << ok << " (Expected 1)" << std::endl;
+    assert(ok);
+}
+
+void test_scan_in_place() {
+    // CRLF endings, padded name, blank lines; views point into the source text
+    std::string text = "ISS (ZARYA)   \r\n" + ISS_L1 + "\r\n" + ISS_L2 + "\r\n\r\n" +
+                       "ISS COPY\n" + ISS_L1 + "\n" + ISS_L2;      // No trailing newline
+    size_t rejected = 99;
+    auto recs = scanTle(text, &rejected);
+    bool ok = recs.size() == 2 && rejected == 0 &&
+              recs[0].name == "ISS (ZARYA)" && recs[0].line1 == ISS_L1 && recs[0].line2 == ISS_L2 &&
+              recs[1].name == "ISS COPY" && recs[1].line2 == ISS_L2 &&
+              recs[0].name.data() >= text.data() && recs[1].line2.data() + recs[1].line2.size() <= text.data() + text.size();
+    std::cout << "Test 2 (Scan in place): " << recs.size() << " records (Expected 2)" << std::endl;
+    assert(ok);
+}
+
+void test_rejects() {
+    std::string bad_sum = ISS_L2;
+    bad_sum[68] = '0';
+    std::string other_id = ISS_L2;
+    other_id[6] = '5';      // Catalog 25545, checksum fixed up below
+    other_id[68] = '8';
+    std::string text = "BAD SUM\n" + ISS_L1 + "\n" + bad_sum + "\n" +
+                       "MISMATCH\n" + ISS_L1 + "\n" + other_id + "\n" +
+                       "SHORT\n1 25544U 98067A\n2 25544  51.6416\n" +
+                       ISS_L1 + "\n" + ISS_L2 + "\n" +             // No name line: skipped
+                       "GOOD\n" + ISS_L1 + "\n" + ISS_L2 + "\n";
+    size_t rejected = 0;
+    auto recs = scanTle(text, &rejected);
+    bool ok = tleChecksumOk(other_id) && recs.size() == 1 && recs[0].name == "GOOD" && rejected == 3;
+    std::cout << "Test 3 (Rejects): " << recs.size() << " kept, " << rejected << " rejected (Expected 1, 3)" << std::endl;
+    assert(ok);
+}
+
+int main() {
+    test_checksum();
+    test_scan_in_place();
+    test_rejects();
+    std::cout << "ALL TESTS PASSED" << std::endl;
+    return 0;
+}
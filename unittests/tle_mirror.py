@@ -0,0 +1,164 @@
+#!/usr/bin/env python3
+"""Local stand-in for Celestrak's gp.php, serving TLE fixtures from a directory.
+
+    python3 tle_mirror.py --dir ./fixtures --port 8089 [--delay 0.5]
+    ./VisibleEphemeris --tle_url http://127.0.0.1:8089/gp.php --groupsel stations,weather
+
+GET <any path>?GROUP=<name>&FORMAT=tle returns <dir>/<name>.txt with an ETag
+(content hash) and Last-Modified (file mtime), and answers conditional
+requests with 304, so the fetcher's parallel and conditional paths can be
+exercised without network access. A path starting with /redirect answers 302
+to the same request without that prefix, carrying a decoy ETag that a client
+must not keep. --delay adds latency per request to make
+serial vs concurrent fetching visible. Each response is logged as
+"<status> <group>".
+
+    python3 tle_mirror.py --selftest
+runs the server against a temporary fixture and checks the protocol.
+"""
+import argparse
+import email.utils
+import hashlib
+import os
+import sys
+import tempfile
+import threading
+import time
+import urllib.error
+import urllib.parse
+import urllib.request
+from http.server import BaseHTTPRequestHandler, ThreadingHTTPServer
+
+
+DECOY_ETAG = '"redirect"'
+
+
+def make_handler(root, delay):
+    class MirrorHandler(BaseHTTPRequestHandler):
+        protocol_version = "HTTP/1.1"   # Keep-alive, so connection reuse shows up
+
+        def do_GET(self):
+            if delay > 0:
+                time.sleep(delay)
+            url = urllib.parse.urlparse(self.path)
+            query = urllib.parse.parse_qs(url.query)
+            group = query.get("GROUP", [""])[0]
+            if url.path.startswith("/redirect/"):
+                target = url._replace(path=url.path[len("/redirect"):]).geturl()
+                self.reply(302, group, b"", {"Location": target, "ETag": DECOY_ETAG})
+                return
+            path = os.path.join(root, os.path.basename(group) + ".txt")
+            if not group or not os.path.isfile(path):
+                self.reply(404, group, b"No GP data found\n")
+                return
+
+            with open(path, "rb") as f:
+                body = f.read()
+            mtime = int(os.path.getmtime(path))
+            etag = '"%s"' % hashlib.sha1(body).hexdigest()
+            headers = {"ETag": etag, "Last-Modified": email.utils.formatdate(mtime, usegmt=True)}
+
+            # If-None-Match takes precedence over If-Modified-Since (RFC 9110)
+            inm = self.headers.get("If-None-Match")
+            ims = self.headers.get("If-Modified-Since")
+            if inm is not None:
+                not_modified = etag in [t.strip() for t in inm.split(",")]
+            elif ims is not None:
+                since = email.utils.parsedate_to_datetime(ims).timestamp()
+                not_modified = mtime <= since
+            else:
+                not_modified = False
+            if not_modified:
+                self.reply(304, group, b"", headers)
+            else:
+                self.reply(200, group, body, headers)
+
+        def reply(self, status, group, body, headers=None):
+            self.send_response(status)
+            for k, v in (headers or {}).items():
+                self.send_header(k, v)
+            if status != 304:
+                self.send_header("Content-Type", "text/plain")
+                self.send_header("Content-Length", str(len(body)))
+            self.end_headers()
+            if body:
+                self.wfile.write(body)
+
+        def log_request(self, code="-", size="-"):
+            query = urllib.parse.parse_qs(urllib.parse.urlparse(self.path).query)
+            sys.stderr.write("%s %s\n" % (code, query.get("GROUP", ["?"])[0]))
+
+    return MirrorHandler
+
+
+def serve(root, port, delay):
+    return ThreadingHTTPServer(("127.0.0.1", port), make_handler(root, delay))
+
+
+def selftest():
+    iss = ("ISS (ZARYA)\n"
+           "1 25544U 98067A   08264.51782528 -.00002182  00000-0 -11606-4 0  2927\n"
+           "2 25544  51.6416 247.4627 0006703 130.5360 325.0288 15.72125391563537\n")
+    with tempfile.TemporaryDirectory() as root:
+        with open(os.path.join(root, "stations.txt"), "w") as f:
+            f.write(iss)
+        server = serve(root, 0, 0.0)
+        threading.Thread(target=server.serve_forever, daemon=True).start()
+        base = "http://127.0.0.1:%d/gp.php" % server.server_address[1]
+
+        def get(group, headers=None):
+            req = urllib.request.Request("%s?GROUP=%s&FORMAT=tle" % (base, group), headers=headers or {})
+            try:
+                with urllib.request.urlopen(req) as r:
+                    return r.status, r.headers, r.read()
+            except urllib.error.HTTPError as e:
+                return e.code, e.headers, b""
+
+        status, headers, body = get("stations")
+        ok = status == 200 and body.decode() == iss and bool(headers["ETag"]) and bool(headers["Last-Modified"])
+        print("Test 1 (Full response with validators): %d (Expected 1)" % ok)
+        assert ok
+
+        etag, modified = headers["ETag"], headers["Last-Modified"]
+        ok = get("stations", {"If-None-Match": etag})[0] == 304 and \
+             get("stations", {"If-Modified-Since": modified})[0] == 304 and \
+             get("stations", {"If-None-Match": '"stale"', "If-Modified-Since": modified})[0] == 200
+        print("Test 2 (Conditional requests): %d (Expected 1)" % ok)
+        assert ok
+
+        with open(os.path.join(root, "stations.txt"), "a") as f:
+            f.write(iss.replace("ISS (ZARYA)", "ISS COPY"))
+        ok = get("stations", {"If-None-Match": etag})[0] == 200 and get("nosuchgroup")[0] == 404
+        print("Test 3 (Changed file and unknown group): %d (Expected 1)" % ok)
+        assert ok
+
+        req = urllib.request.Request("%s?GROUP=stations&FORMAT=tle" % base.replace("/gp.php", "/redirect/gp.php"))
+        with urllib.request.urlopen(req) as r:
+            ok = r.status == 200 and r.url.startswith(base) and r.headers["ETag"] not in (None, DECOY_ETAG)
+        print("Test 4 (Redirect to the plain path): %d (Expected 1)" % ok)
+        assert ok
+
+        server.shutdown()
+    print("ALL TESTS PASSED")
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("--dir", default=".", help="directory holding <group>.txt fixtures")
+    parser.add_argument("--port", type=int, default=8089)
+    parser.add_argument("--delay", type=float, default=0.0, help="seconds of latency per request")
+    parser.add_argument("--selftest", action="store_true")
+    args = parser.parse_args()
+    if args.selftest:
+        selftest()
+        return
+    server = serve(args.dir, args.port, args.delay)
+    print("Serving %s on http://127.0.0.1:%d/gp.php" % (os.path.abspath(args.dir), args.port))
+    try:
+        server.serve_forever()
+    except KeyboardInterrupt:
+        pass
+
+
+if __name__ == "__main__":
+    main()